@@ -0,0 +1,317 @@
+#include "generator.hpp"
+
+#include <clogparser/clogparser.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace {
+  struct Options {
+    clogparser::bench::Generator_options generator;
+    std::size_t repeat = 5;
+    std::optional<std::string> log; //benchmark this file instead of a generated log
+    std::optional<std::string> write; //only write the generated log here
+  };
+
+  void usage() {
+    std::fputs(
+      "usage: clogparser_bench [options]\n"
+      "  --seed N        generator seed (1)\n"
+      "  --raid N        players in the raid (20)\n"
+      "  --encounters N  pulls (10)\n"
+      "  --events N      events a pull (50000)\n"
+      "  --repeat N      runs of each benchmark, the best is reported (5)\n"
+      "  --log PATH      benchmark the log at PATH instead of a generated one\n"
+      "  --write PATH    write the generated log to PATH and exit\n",
+      stderr);
+  }
+
+  std::optional<Options> read_options(int argc, char** argv) {
+    Options returning;
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view arg = argv[i];
+      if (i + 1 == argc) {
+        return std::nullopt;
+      }
+      char const* value = argv[++i];
+      if (arg == "--seed") {
+        returning.generator.seed = std::strtoull(value, nullptr, 10);
+      } else if (arg == "--raid") {
+        returning.generator.raid_size = std::max<std::size_t>(1, std::strtoull(value, nullptr, 10));
+      } else if (arg == "--encounters") {
+        returning.generator.encounters = std::strtoull(value, nullptr, 10);
+      } else if (arg == "--events") {
+        returning.generator.events_per_encounter = std::strtoull(value, nullptr, 10);
+      } else if (arg == "--repeat") {
+        returning.repeat = std::max<std::size_t>(1, std::strtoull(value, nullptr, 10));
+      } else if (arg == "--log") {
+        returning.log = value;
+      } else if (arg == "--write") {
+        returning.write = value;
+      } else {
+        return std::nullopt;
+      }
+    }
+    return returning;
+  }
+
+  //keeps results alive so the work producing them isn't optimized out
+  volatile std::size_t sink;
+
+  //runs run repeat times and prints the fastest, as MB/s of bytes and items/s of what run returns
+  template<typename Run>
+  void bench(char const* name, std::size_t repeat, std::size_t bytes, Run&& run) {
+    double best = 0;
+    std::size_t items = 0;
+    for (std::size_t i = 0; i < repeat; ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      items = run();
+      const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+      if (i == 0 || took.count() < best) {
+        best = took.count();
+      }
+    }
+    sink = items;
+    std::printf("%-24s %10.2f ms %10.1f MB/s %12.0f items/s (%zu items)\n",
+      name, best * 1000, bytes / best / 1e6, items / best, items);
+  }
+
+  void print_stages(clogparser::Parse_stats const& stats) {
+    constexpr std::array<char const*, static_cast<std::size_t>(clogparser::Parse_stats::Stage::COUNT)> NAMES = {
+      "split", "tokenize", "dispatch", "decode", "callback"
+    };
+    std::uint64_t total = 0;
+    for (const std::uint64_t cycles : stats.cycles) {
+      total += cycles;
+    }
+    for (std::size_t i = 0; i < NAMES.size(); ++i) {
+      std::printf("  %-22s %10.1f cycles/line %5.1f%%\n", NAMES[i],
+        static_cast<double>(stats.cycles[i]) / std::max<std::uint64_t>(stats.lines, 1),
+        100.0 * stats.cycles[i] / std::max<std::uint64_t>(total, 1));
+    }
+  }
+
+  struct Split_line {
+    std::size_t offset;
+    clogparser::internal::Partial_parse parsed;
+  };
+
+  std::vector<Split_line> split_lines(std::string_view log) {
+    std::vector<Split_line> returning;
+    clogparser::helpers::Parser parser;
+    std::size_t offset = 0;
+    clogparser::helpers::Parsed res;
+    while ((res = parser.parse_for<'\n', '"'>(log)).found) {
+      clogparser::Parse_error error = clogparser::Parse_error::none;
+      if (const auto parsed = clogparser::internal::parse_line(parser, res.found_str, error)) {
+        returning.push_back(Split_line{ offset, *parsed });
+      }
+      offset += res.found_str.size() + 1;
+      log = res.rest;
+    }
+    return returning;
+  }
+
+  void run(Options const& options, std::string_view log) {
+    const std::size_t repeat = options.repeat;
+    std::printf("%zu MB of log\n\n", log.size() >> 20);
+
+    bench("parse_for", repeat, log.size(), [&]() {
+      clogparser::helpers::Parser parser;
+      std::string_view rest = log;
+      std::size_t lines = 0;
+      clogparser::helpers::Parsed res;
+      while ((res = parser.parse_for<'\n', '"'>(rest)).found) {
+        rest = res.rest;
+        ++lines;
+      }
+      return lines;
+    });
+
+    const std::vector<Split_line> lines = split_lines(log);
+
+    bench("parse_line", repeat, log.size(), [&]() {
+      clogparser::helpers::Parser parser;
+      std::string_view rest = log;
+      std::size_t parsed = 0;
+      clogparser::helpers::Parsed res;
+      while ((res = parser.parse_for<'\n', '"'>(rest)).found) {
+        clogparser::Parse_error error = clogparser::Parse_error::none;
+        parsed += clogparser::internal::parse_line(parser, res.found_str, error).has_value();
+        rest = res.rest;
+      }
+      return parsed;
+    });
+
+    bench("parse_timestamp", repeat, log.size(), [&]() {
+      std::size_t decoded = 0;
+      for (Split_line const& line : lines) {
+        clogparser::Parse_error error = clogparser::Parse_error::none;
+        decoded += clogparser::internal::parse_timestamp(line.parsed.time, error).has_value();
+      }
+      return decoded;
+    });
+
+    bench("Timestamp_decoder", repeat, log.size(), [&]() {
+      clogparser::Timestamp_decoder decoder;
+      std::size_t decoded = 0;
+      for (Split_line const& line : lines) {
+        clogparser::Parse_error error = clogparser::Parse_error::none;
+        decoded += decoder.decode(line.parsed.time, error).has_value();
+      }
+      return decoded;
+    });
+
+    bench("parse_array", repeat, log.size(), [&]() {
+      std::array<std::string_view, 64> columns;
+      std::size_t count = 0;
+      for (Split_line const& line : lines) {
+        clogparser::Parse_error error = clogparser::Parse_error::none;
+        count += clogparser::helpers::parse_array(columns, line.parsed.data, error).size();
+      }
+      return count;
+    });
+
+    bench("Switch_partial_parse", repeat, log.size(), [&]() {
+      std::size_t events = 0;
+      auto cb = [&events]<typename T>(clogparser::Timestamp, T const&, std::size_t) {
+        ++events;
+      };
+      clogparser::Timestamp_decoder decoder;
+      for (Split_line const& line : lines) {
+        clogparser::Parse_error error = clogparser::Parse_error::none;
+        clogparser::internal::Switch_partial_parse<clogparser::events::Type>::check(line.parsed, line.offset, cb, decoder, error);
+      }
+      return events;
+    });
+
+    std::vector<clogparser::events::Type> events;
+    clogparser::Bump_arena arrays;
+    {
+      auto cb = [&events, &arrays]<typename T>(clogparser::Timestamp, T const& event, std::size_t)
+        requires std::is_constructible_v<clogparser::events::Type, T> {
+        events.emplace_back(clogparser::internal::keep_arrays(arrays, event));
+      };
+      clogparser::Parser<decltype(cb)&> parser{ cb };
+      parser.parse_all(log);
+    }
+
+    bench("String_store::get", repeat, log.size(), [&]() {
+      clogparser::String_store store;
+      for (clogparser::events::Type const& event : events) {
+        std::visit([&store](auto const& held) { store.get(held); }, event);
+      }
+      return events.size();
+    });
+
+    bench("Parser::parse", repeat, log.size(), [&]() {
+      constexpr std::size_t CHUNK_SIZE = std::size_t{ 64 } << 10;
+      std::size_t events = 0;
+      auto cb = [&events]<typename T>(clogparser::Timestamp, T const&, std::size_t) {
+        ++events;
+      };
+      clogparser::Parser<decltype(cb)&> parser{ cb };
+      for (std::size_t at = 0; at < log.size(); at += CHUNK_SIZE) {
+        parser.parse(log.substr(at, CHUNK_SIZE));
+      }
+      return events;
+    });
+
+    bench("Parser::parse_all", repeat, log.size(), [&]() {
+      std::size_t events = 0;
+      auto cb = [&events]<typename T>(clogparser::Timestamp, T const&, std::size_t) {
+        ++events;
+      };
+      clogparser::Parser<decltype(cb)&> parser{ cb };
+      parser.parse_all(log);
+      return events;
+    });
+
+    bench("events_in", repeat, log.size(), [&]() {
+      std::size_t events = 0;
+      for (clogparser::Event_ref const& event : clogparser::events_in(log)) {
+        events += event.offset != log.size();
+      }
+      return events;
+    });
+
+    using Combatant_info_only = clogparser::Event_filter<clogparser::events::Combatant_info>;
+    bench("COMBATANT_INFO", repeat, log.size(), [&]() {
+      std::size_t infos = 0;
+      std::size_t specs = 0;
+      auto cb = [&infos, &specs](clogparser::Timestamp, clogparser::events::Combatant_info const& event, std::size_t) {
+        ++infos;
+        specs += static_cast<std::size_t>(event.current_spec_id);
+      };
+      clogparser::Parser<decltype(cb)&, Combatant_info_only> parser{ cb };
+      parser.parse_all(log);
+      sink = specs;
+      return infos;
+    });
+
+    bench("Lazy<Combatant_info>", repeat, log.size(), [&]() {
+      std::size_t infos = 0;
+      std::size_t specs = 0;
+      auto cb = [&infos, &specs](clogparser::Timestamp, clogparser::Lazy<clogparser::events::Combatant_info> const& event, std::size_t) {
+        ++infos;
+        specs += static_cast<std::size_t>(event.current_spec_id());
+      };
+      clogparser::Parser<decltype(cb)&, Combatant_info_only> parser{ cb };
+      parser.parse_all(log);
+      sink = specs;
+      return infos;
+    });
+
+    clogparser::Parse_stats stats;
+    bench("Parser with Parse_stats", repeat, log.size(), [&]() {
+      std::size_t events = 0;
+      auto cb = [&events]<typename T>(clogparser::Timestamp, T const&, std::size_t) {
+        ++events;
+      };
+      clogparser::Parser<decltype(cb)&, clogparser::All_events, clogparser::Parse_stats> parser{ cb };
+      parser.parse_all(log);
+      stats = parser.stats();
+      return events;
+    });
+    print_stages(stats);
+
+    bench("Log", repeat, log.size(), [&]() {
+      clogparser::Log stored;
+      clogparser::Parser<decltype(stored.parsing_cb())> parser{ stored.parsing_cb() };
+      parser.parse_all(log);
+      return stored.events.size();
+    });
+  }
+}
+
+int main(int argc, char** argv) {
+  const std::optional<Options> options = read_options(argc, argv);
+  if (!options) {
+    usage();
+    return 1;
+  }
+
+  if (options->log) {
+    const clogparser::Mapped_log log{ *options->log };
+    run(*options, log.data());
+    return 0;
+  }
+
+  const std::string log = clogparser::bench::generate_log(options->generator);
+  if (options->write) {
+    std::ofstream out{ *options->write, std::ios::binary };
+    out.write(log.data(), static_cast<std::streamsize>(log.size()));
+    return out ? 0 : 1;
+  }
+  run(*options, log);
+  return 0;
+}
@@ -0,0 +1,329 @@
+#include "generator.hpp"
+
+#include <array>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+  //splitmix64, so the log doesn't depend on the standard library's generators or distributions
+  struct Random {
+    std::uint64_t state;
+
+    std::uint64_t next() noexcept {
+      std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      return z ^ (z >> 31);
+    }
+    //in [low, high]
+    std::uint64_t between(std::uint64_t low, std::uint64_t high) noexcept {
+      return low + next() % (high - low + 1);
+    }
+    template<typename T, std::size_t N>
+    T const& pick(std::array<T, N> const& from) noexcept {
+      return from[next() % N];
+    }
+  };
+
+  struct Spell {
+    std::uint32_t id;
+    std::string_view name; //quoted in the log
+    std::string_view school;
+  };
+
+  constexpr std::array<Spell, 8> DAMAGE_SPELLS = { {
+    { 133, "Fireball", "0x4" },
+    { 11366, "Pyroblast", "0x4" },
+    { 116, "Frostbolt", "0x10" },
+    { 585, "Smite", "0x2" },
+    { 34914, "Vampiric Touch", "0x20" },
+    { 589, "Shadow Word: Pain", "0x20" },
+    { 403631, "Breath of Eons, Unbound", "0x44" },
+    { 396286, "Upheaval", "0x8" },
+  } };
+  constexpr std::array<Spell, 4> HEAL_SPELLS = { {
+    { 2061, "Flash Heal", "0x2" },
+    { 139, "Renew", "0x2" },
+    { 774, "Rejuvenation", "0x8" },
+    { 366155, "Reversion, Echoed", "0x40" },
+  } };
+  constexpr std::array<Spell, 4> AURA_SPELLS = { {
+    { 1459, "Arcane Intellect", "0x40" },
+    { 21562, "Power Word: Fortitude", "0x2" },
+    { 395152, "Ebon Might", "0x8" },
+    { 410089, "Prescience, Foreseen", "0x40" },
+  } };
+
+  struct Boss {
+    std::int32_t encounter_id;
+    std::string_view name;
+  };
+
+  constexpr std::array<Boss, 4> BOSSES = { {
+    { 2688, "Kazzara, the Hellforged" },
+    { 2687, "The Amalgamation Chamber" },
+    { 2693, "The Forgotten Experiments" },
+    { 2685, "Scalecommander Sarkareth" },
+  } };
+
+  struct Unit {
+    std::string guid;
+    std::string name; //with its quotes, or nil
+    std::string_view flags;
+  };
+
+  enum class Kind {
+    spell_damage,
+    spell_periodic_damage,
+    spell_aura_applied,
+    spell_aura_removed,
+    spell_aura_refresh,
+    spell_aura_applied_dose,
+    spell_heal,
+    spell_periodic_heal,
+    spell_cast_success,
+    swing_damage,
+    spell_missed,
+    spell_absorbed
+  };
+
+  //out of 100, weighted the way a raid log is
+  constexpr std::array<std::pair<Kind, unsigned>, 12> MIX = { {
+    { Kind::spell_damage, 26 },
+    { Kind::spell_periodic_damage, 20 },
+    { Kind::spell_aura_applied, 9 },
+    { Kind::spell_aura_removed, 9 },
+    { Kind::spell_aura_refresh, 4 },
+    { Kind::spell_aura_applied_dose, 2 },
+    { Kind::spell_heal, 9 },
+    { Kind::spell_periodic_heal, 7 },
+    { Kind::spell_cast_success, 6 },
+    { Kind::swing_damage, 5 },
+    { Kind::spell_missed, 2 },
+    { Kind::spell_absorbed, 1 },
+  } };
+
+  struct Writer {
+    std::string& out;
+
+    Writer& operator<<(std::string_view in) {
+      out.append(in);
+      return *this;
+    }
+    Writer& operator<<(char in) {
+      out.push_back(in);
+      return *this;
+    }
+    template<typename T> requires std::is_integral_v<T>
+    Writer& operator<<(T in) {
+      std::array<char, 24> digits;
+      const auto end = std::to_chars(digits.begin(), digits.end(), in).ptr;
+      out.append(digits.data(), end);
+      return *this;
+    }
+    Writer& hex(std::uint64_t in, int width) {
+      std::array<char, 16> digits;
+      for (int i = width - 1; i >= 0; --i) {
+        digits[i] = "0123456789ABCDEF"[in & 0xf];
+        in >>= 4;
+      }
+      out.append(digits.data(), width);
+      return *this;
+    }
+  };
+
+  struct Generator {
+    Generator(clogparser::bench::Generator_options const& options, std::string& out) :
+      options(options),
+      random{ options.seed },
+      write{ out } {
+      for (std::size_t i = 0; i < options.raid_size; ++i) {
+        Unit& player = players.emplace_back();
+        std::string guid = "Player-1403-";
+        Writer{ guid }.hex(random.next() & 0xffffffff, 8);
+        player.guid = std::move(guid);
+        Writer{ player.name } << "\"Player" << i << "-Realm\"";
+        player.flags = "0x512";
+      }
+    }
+
+    void generate() {
+      time_ms = (19 * 3600 + 44 * 60) * 1000;
+      line("COMBAT_LOG_VERSION") << ",20,ADVANCED_LOG_ENABLED,1,BUILD_VERSION,10.1.0,PROJECT_ID,1\n";
+      line("ZONE_CHANGE") << ",2569,\"Aberrus, the Shadowed Crucible\",16\n";
+      for (std::size_t i = 0; i < options.encounters; ++i) {
+        encounter(BOSSES[i % BOSSES.size()]);
+      }
+    }
+  private:
+    void encounter(Boss const& boss) {
+      std::string guid = "Creature-0-3019-2569-1234-";
+      Writer{ guid } << (200000 + boss.encounter_id) << '-';
+      Writer{ guid }.hex(random.next() & 0xffffffffff, 10);
+      std::string name;
+      Writer{ name } << '"' << boss.name << '"';
+      const Unit creature{ std::move(guid), std::move(name), "0x10a48" };
+
+      line("ENCOUNTER_START") << ',' << boss.encounter_id << ",\"" << boss.name << "\",16," << options.raid_size << ",2569\n";
+      for (Unit const& player : players) {
+        combatant_info(player);
+      }
+      for (std::size_t i = 0; i < options.events_per_encounter; ++i) {
+        event(creature);
+      }
+      line("UNIT_DIED") << ",0000000000000000,nil,0x80000000,0x80000000,";
+      unit(creature) << ",0\n";
+      line("ENCOUNTER_END") << ',' << boss.encounter_id << ",\"" << boss.name << "\",16," << options.raid_size << ",1,2569\n";
+      time_ms += random.between(30000, 120000); //between pulls
+    }
+
+    void combatant_info(Unit const& player) {
+      line("COMBATANT_INFO") << ',' << player.guid << ",1";
+      for (int i = 0; i < 21; ++i) {
+        write << ',' << random.between(0, 20000);
+      }
+      write << ",63,[";
+      const std::size_t talents = random.between(30, 45);
+      for (std::size_t i = 0; i < talents; ++i) {
+        write << (i == 0 ? "(" : ",(") << random.between(60000, 100000) << ',' << random.between(80000, 120000) << ',' << random.between(1, 2) << ')';
+      }
+      write << "],(0,0,0,0),[";
+      for (int i = 0; i < 16; ++i) {
+        write << (i == 0 ? "(" : ",(") << random.between(190000, 210000) << ',' << random.between(400, 450) << ",(";
+        if (random.between(0, 3) == 0) {
+          write << random.between(6000, 7000) << ",0,0";
+        }
+        write << "),(" << random.between(1000, 9000) << ',' << random.between(1000, 9000) << "),())";
+      }
+      write << "],[";
+      for (int i = 0; i < 4; ++i) {
+        write << (i == 0 ? "" : ",") << player.guid << ',' << AURA_SPELLS[i].id;
+      }
+      write << "],0,0,0,0\n";
+    }
+
+    void event(Unit const& creature) {
+      time_ms += random.between(0, 20);
+      Unit const& player = players[random.next() % players.size()];
+      Unit const& other = players[random.next() % players.size()];
+
+      unsigned roll = static_cast<unsigned>(random.between(0, 99));
+      Kind kind = MIX.back().first;
+      for (auto const& [candidate, weight] : MIX) {
+        if (roll < weight) {
+          kind = candidate;
+          break;
+        }
+        roll -= weight;
+      }
+
+      switch (kind) {
+      case Kind::spell_damage:
+      case Kind::spell_periodic_damage: {
+        header(kind == Kind::spell_damage ? "SPELL_DAMAGE" : "SPELL_PERIODIC_DAMAGE", player, creature);
+        spell(random.pick(DAMAGE_SPELLS));
+        advanced(creature);
+        const std::uint64_t amount = random.between(1000, 200000);
+        write << ',' << amount << ',' << amount - amount / 10 << ",-1,4,0,0,0," << (random.between(0, 3) == 0 ? "1" : "nil") << ",nil,nil\n";
+        break;
+      }
+      case Kind::spell_aura_applied:
+      case Kind::spell_aura_removed:
+      case Kind::spell_aura_refresh:
+        header(kind == Kind::spell_aura_applied ? "SPELL_AURA_APPLIED" : kind == Kind::spell_aura_removed ? "SPELL_AURA_REMOVED" : "SPELL_AURA_REFRESH", player, other);
+        spell(random.pick(AURA_SPELLS));
+        write << ",BUFF\n";
+        break;
+      case Kind::spell_aura_applied_dose:
+        header("SPELL_AURA_APPLIED_DOSE", player, other);
+        spell(random.pick(AURA_SPELLS));
+        write << ",BUFF," << random.between(2, 10) << '\n';
+        break;
+      case Kind::spell_heal:
+      case Kind::spell_periodic_heal: {
+        header(kind == Kind::spell_heal ? "SPELL_HEAL" : "SPELL_PERIODIC_HEAL", player, other);
+        spell(random.pick(HEAL_SPELLS));
+        advanced(other);
+        const std::uint64_t amount = random.between(1000, 100000);
+        write << ',' << amount << ',' << amount << ',' << random.between(0, amount) << ",0,nil\n";
+        break;
+      }
+      case Kind::spell_cast_success:
+        header("SPELL_CAST_SUCCESS", player, creature);
+        spell(random.pick(DAMAGE_SPELLS));
+        advanced(player);
+        write << '\n';
+        break;
+      case Kind::swing_damage: {
+        header("SWING_DAMAGE", creature, player);
+        advanced(creature);
+        const std::uint64_t amount = random.between(10000, 60000);
+        write << ',' << amount << ',' << amount << ",-1,1,0,0,0,nil,nil,nil\n";
+        break;
+      }
+      case Kind::spell_missed:
+        header("SPELL_MISSED", player, creature);
+        spell(random.pick(DAMAGE_SPELLS));
+        write << ",ABSORB,nil," << random.between(1000, 5000) << ',' << random.between(5000, 9000) << '\n';
+        break;
+      case Kind::spell_absorbed:
+        header("SPELL_ABSORBED", creature, player);
+        spell(random.pick(DAMAGE_SPELLS));
+        write << ',';
+        unit(other);
+        spell(AURA_SPELLS[1]);
+        write << ',' << random.between(1000, 5000) << ',' << random.between(5000, 9000) << ",nil\n";
+        break;
+      }
+    }
+
+    Writer& line(std::string_view name) {
+      const std::uint64_t in_day = time_ms % (24 * 3600 * 1000);
+      const std::uint64_t hours = in_day / (3600 * 1000);
+      const std::uint64_t minutes = in_day / (60 * 1000) % 60;
+      const std::uint64_t seconds = in_day / 1000 % 60;
+      const std::uint64_t ms = in_day % 1000;
+      write << "4/" << (21 + time_ms / (24 * 3600 * 1000)) << ' ' << hours
+        << (minutes < 10 ? ":0" : ":") << minutes
+        << (seconds < 10 ? ":0" : ":") << seconds
+        << (ms < 10 ? ".00" : ms < 100 ? ".0" : ".") << ms
+        << "  " << name;
+      return write;
+    }
+
+    Writer& unit(Unit const& in) {
+      return write << in.guid << ',' << in.name << ',' << in.flags << ",0x0";
+    }
+
+    void header(std::string_view name, Unit const& source, Unit const& dest) {
+      line(name) << ',';
+      unit(source) << ',';
+      unit(dest);
+    }
+
+    void spell(Spell const& in) {
+      write << ',' << in.id << ",\"" << in.name << "\"," << in.school;
+    }
+
+    void advanced(Unit const& of) {
+      write << ',' << of.guid << ",0000000000000000," << random.between(1, 10000000) << ",10000000,0,0,5043,0,0,100,100,0,-1234.5,567.8,2166,3.1416,72";
+    }
+
+    clogparser::bench::Generator_options const& options;
+    Random random;
+    Writer write;
+    std::vector<Unit> players;
+    std::uint64_t time_ms = 0;
+  };
+}
+
+std::string clogparser::bench::generate_log(Generator_options const& options) {
+  std::string returning;
+  returning.reserve(options.encounters * (options.events_per_encounter + options.raid_size) * 300);
+  Generator{ options, returning }.generate();
+  return returning;
+}
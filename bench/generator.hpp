@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace clogparser::bench {
+  struct Generator_options {
+    std::uint64_t seed = 1;
+    std::size_t raid_size = 20;
+    std::size_t encounters = 10;
+    std::size_t events_per_encounter = 50000;
+  };
+
+  //a combat log of options.encounters pulls of a raid of options.raid_size players. every
+  //event is decided by seed, so the same options always make the same log. most events are
+  //damage, periodic damage and auras as in a real raid, each pull starts with a burst of
+  //COMBATANT_INFO, and boss, zone and some spell names are quoted with commas in them
+  std::string generate_log(Generator_options const& options);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace clogparser {
+  //arrays handed out back to back from blocks that reset() keeps, so once an arena has
+  //grown to what's needed, allocating is a pointer bump. nothing in it is destroyed, so it
+  //only holds trivially destructible types, and everything in it goes at once on reset()
+  struct Bump_arena {
+  public:
+    //count default initialized Ts
+    template<typename T>
+    std::span<T> allocate(std::size_t count) {
+      static_assert(std::is_trivially_destructible_v<T> && alignof(T) <= alignof(std::max_align_t));
+      if (count == 0) {
+        return {};
+      }
+      T* const returning = static_cast<T*>(allocate_(sizeof(T) * count, alignof(T)));
+      std::uninitialized_default_construct_n(returning, count);
+      return { returning, count };
+    }
+
+    template<typename T>
+    std::span<const T> copy(std::span<const T> in) {
+      const std::span<T> returning = allocate<T>(in.size());
+      std::uninitialized_copy(in.begin(), in.end(), returning.begin());
+      return returning;
+    }
+
+    //frees everything allocated, keeping the blocks to allocate from again
+    void reset() noexcept {
+      block_ = 0;
+      used_ = 0;
+    }
+
+    //frees everything allocated and the blocks
+    void clear() noexcept;
+
+    //bytes taken by the blocks
+    std::size_t capacity() const noexcept;
+  private:
+    struct Block {
+      std::unique_ptr<std::byte[]> data;
+      std::size_t size;
+    };
+
+    static constexpr std::size_t BLOCK_SIZE = std::size_t{ 64 } << 10;
+
+    void* allocate_(std::size_t size, std::size_t alignment) {
+      const std::size_t start = (used_ + alignment - 1) & ~(alignment - 1);
+      if (block_ < blocks_.size() && start + size <= blocks_[block_].size) {
+        used_ = start + size;
+        return blocks_[block_].data.get() + start;
+      }
+      return next_block_(size);
+    }
+    void* next_block_(std::size_t size);
+
+    std::vector<Block> blocks_;
+    std::size_t block_ = 0; //being allocated from
+    std::size_t used_ = 0; //of that block
+  };
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include <clogparser/parser.hpp>
+#include <clogparser/mapped_log.hpp>
+#include <clogparser/columnar_log.hpp>
+
+namespace clogparser {
+  //a Compact_event as it's kept in a cache, with the event's line standing in for its payload
+  struct Cached_event {
+    static constexpr Unit_id NO_UNIT = std::numeric_limits<Unit_id>::max();
+
+    std::int64_t time; //Timestamp::since_epoch() in ms
+    std::int64_t amount; //the damage, healing or absorb, 0 for events without one
+    std::uint64_t line; //offset of the event's line in the log
+    Unit_id source; //NO_UNIT for events without a combat header
+    Unit_id dest;
+    std::uint32_t spell; //0 for events without a spell. spell ids fit in 32 bits, so it's the low 32 of Spell_info::id
+    std::uint8_t type; //index of the event's type in events::Type
+    std::uint8_t padding[3]; //0, so no uninitialized bytes are written
+  };
+  static_assert(sizeof(Cached_event) == 40);
+
+  struct Cached_encounter {
+    std::uint64_t first_event; //index of its ENCOUNTER_START
+    std::uint64_t end_event; //one past its ENCOUNTER_END, or past the last event if it never ended
+    std::int64_t start_time;
+    std::int64_t end_time;
+    std::int32_t encounter_id;
+    std::uint32_t name; //Cached_log::string id
+    Difficulty difficulty_id;
+    std::uint8_t instance_size;
+    bool success;
+    bool ended;
+    std::uint32_t padding; //0, so no uninitialized bytes are written
+  };
+  static_assert(sizeof(Cached_encounter) == 48);
+
+  //where a string is in a cache's string data
+  struct Cached_string {
+    std::uint64_t offset;
+    std::uint64_t size;
+  };
+
+  //parses log and writes a cache of it to cache, replacing what's there only once it's
+  //complete. timestamps need their years for event times to be comparable across new year
+  void write_cache(std::filesystem::path const& cache, Mapped_log const& log, Timestamp_decoder timestamps = {});
+
+  //a cache made by write_cache, mapped as it is on disk. nothing is decoded up front, so
+  //opening one takes about as long as mapping it
+  struct Cached_log {
+  public:
+    //throws std::runtime_error if cache wasn't written by this version for a log the
+    //size and start of log
+    Cached_log(std::filesystem::path const& cache, std::filesystem::path const& log);
+
+    //the cache of log at cache, writing it first if it's missing or out of date
+    static Cached_log open(std::filesystem::path const& cache, std::filesystem::path const& log);
+
+    std::span<Cached_event const> events() const noexcept {
+      return events_;
+    }
+    std::span<Guid const> units() const noexcept {
+      return units_;
+    }
+    std::span<Cached_encounter const> encounters() const noexcept {
+      return encounters_;
+    }
+    std::string_view string(std::uint32_t id) const noexcept;
+
+    //parses event's line again, the views in the result point into log() and its arrays
+    //into arrays
+    std::optional<events::Type> decode(Cached_event const& event, Bump_arena& arrays) const;
+
+    Mapped_log const& log() const noexcept {
+      return log_;
+    }
+  private:
+    Mapped_log cache_;
+    Mapped_log log_;
+    std::span<Cached_event const> events_;
+    std::span<Guid const> units_;
+    std::span<Cached_encounter const> encounters_;
+    std::span<Cached_string const> strings_;
+    char const* string_data_ = nullptr;
+  };
+}
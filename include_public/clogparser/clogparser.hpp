@@ -1,4 +1,13 @@
 #pragma once
 
 #include <clogparser/parser.hpp>
+#include <clogparser/mapped_log.hpp>
+#include <clogparser/parallel.hpp>
+#include <clogparser/columnar_log.hpp>
+#include <clogparser/compact_log.hpp>
+#include <clogparser/cache.hpp>
+#include <clogparser/encounter_index.hpp>
+#include <clogparser/log_follower.hpp>
+#include <clogparser/compressed_log.hpp>
+#include <clogparser/event_range.hpp>
 #include <clogparser/types.hpp>
\ No newline at end of file
@@ -0,0 +1,517 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <clogparser/parser.hpp>
+
+namespace clogparser {
+  //dense ids for the units a log has seen, in the order it first saw them
+  using Unit_id = std::uint32_t;
+
+  struct Unit_table {
+  public:
+    Unit_id id(Guid guid) {
+      const auto [found, inserted] = ids_.try_emplace(guid, static_cast<Unit_id>(guids_.size()));
+      if (inserted) {
+        guids_.push_back(guid);
+      }
+      return found->second;
+    }
+    std::optional<Unit_id> find(Guid guid) const noexcept {
+      const auto found = ids_.find(guid);
+      if (found == ids_.end()) {
+        return std::nullopt;
+      }
+      return found->second;
+    }
+
+    Guid operator[](Unit_id id) const noexcept {
+      return guids_[id];
+    }
+    //indexed by id
+    std::vector<Guid> const& guids() const noexcept {
+      return guids_;
+    }
+    std::size_t size() const noexcept {
+      return guids_.size();
+    }
+
+    void clear() noexcept {
+      guids_.clear();
+      ids_.clear();
+    }
+  private:
+    std::vector<Guid> guids_;
+    std::unordered_map<Guid, Unit_id> ids_;
+  };
+
+  namespace internal {
+    template<typename T>
+    constexpr bool has_units = requires(T const& event) { event.combat_header.source.guid; };
+
+    template<typename T>
+    constexpr bool has_spell = requires(T const& event) { event.spell.id; };
+
+    template<typename T>
+    constexpr bool has_amount = requires(T const& event) { event.damage.final; }
+      || requires(T const& event) { event.heal.final; }
+      || requires(T const& event) { event.absorbed_amount; }
+      || requires(T const& event) { { event.absorbed } -> std::convertible_to<std::int64_t>; };
+
+    //the damage, healing or absorb an event is about
+    template<typename T>
+    std::int64_t amount_of(T const& event) noexcept {
+      if constexpr (requires { event.damage.final; }) {
+        return event.damage.final;
+      } else if constexpr (requires { event.heal.final; }) {
+        return static_cast<std::int64_t>(event.heal.final);
+      } else if constexpr (requires { event.absorbed_amount; }) {
+        return event.absorbed_amount;
+      } else {
+        return event.absorbed;
+      }
+    }
+
+    template<typename T>
+    void set_amount(T& event, std::int64_t amount) noexcept {
+      if constexpr (requires { event.damage.final; }) {
+        event.damage.final = amount;
+      } else if constexpr (requires { event.heal.final; }) {
+        event.heal.final = static_cast<std::uint64_t>(amount);
+      } else if constexpr (requires { event.absorbed_amount; }) {
+        event.absorbed_amount = amount;
+      } else {
+        event.absorbed = amount;
+      }
+    }
+
+    //what's left of the parts of an event with a field in the hot columns
+    struct Unit_rest {
+      std::string_view name;
+      Unit_flags flags;
+      Raid_flags raid_flags;
+    };
+    struct Header_rest {
+      Unit_rest source;
+      Unit_rest dest;
+    };
+    struct Spell_rest {
+      std::string_view name;
+      Spell_schools school;
+    };
+    struct Damage_rest {
+      std::int64_t initial;
+      std::int64_t overkill;
+      Spell_schools school;
+      std::int64_t resisted;
+      std::uint64_t blocked;
+      std::int64_t absorbed;
+      bool crit;
+      bool glancing;
+      bool crushing;
+    };
+    struct Heal_rest {
+      std::uint64_t initial;
+      std::uint64_t overhealing;
+      std::uint64_t absorbed;
+      bool crit;
+    };
+
+    inline Unit_rest rest_of(events::Unit const& in) noexcept {
+      return { in.name, in.flags, in.raid_flags };
+    }
+    inline Header_rest rest_of(events::Combat_header const& in) noexcept {
+      return { rest_of(in.source), rest_of(in.dest) };
+    }
+    inline Spell_rest rest_of(events::Spell_info const& in) noexcept {
+      return { in.name, in.school };
+    }
+    inline Damage_rest rest_of(events::Damage const& in) noexcept {
+      return { in.initial, in.overkill, in.school, in.resisted, in.blocked, in.absorbed, in.crit, in.glancing, in.crushing };
+    }
+    inline Heal_rest rest_of(events::Heal const& in) noexcept {
+      return { in.initial, in.overhealing, in.absorbed, in.crit };
+    }
+
+    inline void restore(events::Unit& out, Unit_rest const& in) noexcept {
+      out.name = in.name;
+      out.flags = in.flags;
+      out.raid_flags = in.raid_flags;
+    }
+    inline void restore(events::Combat_header& out, Header_rest const& in) noexcept {
+      restore(out.source, in.source);
+      restore(out.dest, in.dest);
+    }
+    inline void restore(events::Spell_info& out, Spell_rest const& in) noexcept {
+      out.name = in.name;
+      out.school = in.school;
+    }
+    inline void restore(events::Damage& out, Damage_rest const& in) noexcept {
+      out = { out.final, in.initial, in.overkill, in.school, in.resisted, in.blocked, in.absorbed, in.crit, in.glancing, in.crushing };
+    }
+    inline void restore(events::Heal& out, Heal_rest const& in) noexcept {
+      out = { out.final, in.initial, in.overhealing, in.absorbed, in.crit };
+    }
+
+    template<typename Member>
+    struct Member_of;
+
+    template<typename Part, typename T>
+    struct Member_of<Part T::*> {
+      using Type = Part;
+    };
+
+    //a member of an event as it's kept with the cold fields. only the combat header, the
+    //spell named spell, and the damage or heal have fields in the hot columns
+    template<typename T, auto Member>
+    constexpr bool split_member() noexcept {
+      using Part = typename Member_of<decltype(Member)>::Type;
+      if constexpr (std::is_same_v<Part, events::Spell_info>) {
+        if constexpr (has_spell<T>) {
+          return Member == &T::spell;
+        } else {
+          return false;
+        }
+      } else {
+        return std::is_same_v<Part, events::Combat_header> || std::is_same_v<Part, events::Damage> || std::is_same_v<Part, events::Heal>;
+      }
+    }
+
+    template<typename T, auto Member>
+    constexpr auto cold_member() noexcept {
+      using Part = typename Member_of<decltype(Member)>::Type;
+      if constexpr (split_member<T, Member>()) {
+        return std::type_identity<decltype(rest_of(std::declval<Part const&>()))>{};
+      } else {
+        return std::type_identity<Part>{};
+      }
+    }
+
+    template<typename T, auto Member>
+    using Cold_member = typename decltype(cold_member<T, Member>())::type;
+
+    //the members of T that aren't wholly in the hot columns. amounts that aren't part of a
+    //damage or heal are left out, they're all in the amount column
+    template<typename T, auto... Members>
+    struct Cold_members {
+      using Type = std::tuple<Cold_member<T, Members>...>;
+
+      static Type split(T const& event) noexcept {
+        return Type{ split_<Members>(event)... };
+      }
+      static void restore(T& event, Type const& cold) noexcept {
+        restore_(event, cold, std::index_sequence_for<decltype(Members)...>{});
+      }
+    private:
+      template<auto Member>
+      static Cold_member<T, Member> split_(T const& event) noexcept {
+        if constexpr (split_member<T, Member>()) {
+          return rest_of(event.*Member);
+        } else {
+          return event.*Member;
+        }
+      }
+
+      template<std::size_t... Is>
+      static void restore_(T& event, Type const& cold, std::index_sequence<Is...>) noexcept {
+        (restore_member_<Members>(event, std::get<Is>(cold)), ...);
+      }
+      template<auto Member>
+      static void restore_member_(T& event, Cold_member<T, Member> const& cold) noexcept {
+        if constexpr (split_member<T, Member>()) {
+          internal::restore(event.*Member, cold);
+        } else {
+          event.*Member = cold;
+        }
+      }
+    };
+
+    //events without hot fields are kept whole
+    template<typename T>
+    struct Cold_layout {
+      static_assert(!has_units<T> && !has_spell<T> && !has_amount<T>, "T needs its cold members listed");
+
+      using Type = T;
+
+      static Type split(T const& event) noexcept {
+        return event;
+      }
+      static void restore(T& event, Type const& cold) noexcept {
+        event = cold;
+      }
+    };
+
+    template<> struct Cold_layout<events::Spell_aura_applied> : Cold_members<events::Spell_aura_applied,
+      &events::Spell_aura_applied::combat_header, &events::Spell_aura_applied::spell,
+      &events::Spell_aura_applied::aura_type, &events::Spell_aura_applied::remaining_points> {};
+    template<> struct Cold_layout<events::Spell_aura_applied_dose> : Cold_members<events::Spell_aura_applied_dose,
+      &events::Spell_aura_applied_dose::combat_header, &events::Spell_aura_applied_dose::spell,
+      &events::Spell_aura_applied_dose::aura_type, &events::Spell_aura_applied_dose::new_dosage> {};
+    template<> struct Cold_layout<events::Spell_aura_refresh> : Cold_members<events::Spell_aura_refresh,
+      &events::Spell_aura_refresh::combat_header, &events::Spell_aura_refresh::spell,
+      &events::Spell_aura_refresh::aura_type, &events::Spell_aura_refresh::remaining_points> {};
+    template<> struct Cold_layout<events::Spell_aura_removed> : Cold_members<events::Spell_aura_removed,
+      &events::Spell_aura_removed::combat_header, &events::Spell_aura_removed::spell,
+      &events::Spell_aura_removed::aura_type, &events::Spell_aura_removed::remaining_points> {};
+    template<> struct Cold_layout<events::Spell_aura_removed_dose> : Cold_members<events::Spell_aura_removed_dose,
+      &events::Spell_aura_removed_dose::combat_header, &events::Spell_aura_removed_dose::spell,
+      &events::Spell_aura_removed_dose::aura_type, &events::Spell_aura_removed_dose::new_dosage> {};
+    template<> struct Cold_layout<events::Spell_periodic_damage> : Cold_members<events::Spell_periodic_damage,
+      &events::Spell_periodic_damage::combat_header, &events::Spell_periodic_damage::spell,
+      &events::Spell_periodic_damage::advanced, &events::Spell_periodic_damage::damage> {};
+    template<> struct Cold_layout<events::Spell_periodic_damage_support> : Cold_members<events::Spell_periodic_damage_support,
+      &events::Spell_periodic_damage_support::combat_header, &events::Spell_periodic_damage_support::spell,
+      &events::Spell_periodic_damage_support::advanced, &events::Spell_periodic_damage_support::damage,
+      &events::Spell_periodic_damage_support::supporter> {};
+    template<> struct Cold_layout<events::Spell_periodic_missed> : Cold_members<events::Spell_periodic_missed,
+      &events::Spell_periodic_missed::combat_header, &events::Spell_periodic_missed::spell,
+      &events::Spell_periodic_missed::type, &events::Spell_periodic_missed::unk1,
+      &events::Spell_periodic_missed::final, &events::Spell_periodic_missed::initial,
+      &events::Spell_periodic_missed::unk2> {};
+    template<> struct Cold_layout<events::Spell_periodic_heal> : Cold_members<events::Spell_periodic_heal,
+      &events::Spell_periodic_heal::combat_header, &events::Spell_periodic_heal::spell,
+      &events::Spell_periodic_heal::advanced, &events::Spell_periodic_heal::heal> {};
+    template<> struct Cold_layout<events::Spell_absorbed> : Cold_members<events::Spell_absorbed,
+      &events::Spell_absorbed::combat_header, &events::Spell_absorbed::dmg_spell,
+      &events::Spell_absorbed::absorber, &events::Spell_absorbed::absorber_spell,
+      &events::Spell_absorbed::unmitigated, &events::Spell_absorbed::critical> {};
+    template<> struct Cold_layout<events::Spell_heal_absorbed> : Cold_members<events::Spell_heal_absorbed,
+      &events::Spell_heal_absorbed::combat_header, &events::Spell_heal_absorbed::absorbing_spell,
+      &events::Spell_heal_absorbed::absorbed, &events::Spell_heal_absorbed::absorbed_spell,
+      &events::Spell_heal_absorbed::unmitigated> {};
+    template<> struct Cold_layout<events::Swing_missed> : Cold_members<events::Swing_missed,
+      &events::Swing_missed::combat_header, &events::Swing_missed::type,
+      &events::Swing_missed::unk1, &events::Swing_missed::final,
+      &events::Swing_missed::initial, &events::Swing_missed::unk2> {};
+    template<> struct Cold_layout<events::Swing_damage> : Cold_members<events::Swing_damage,
+      &events::Swing_damage::combat_header, &events::Swing_damage::advanced,
+      &events::Swing_damage::damage> {};
+    template<> struct Cold_layout<events::Swing_damage_landed> : Cold_members<events::Swing_damage_landed,
+      &events::Swing_damage_landed::combat_header, &events::Swing_damage_landed::advanced,
+      &events::Swing_damage_landed::damage> {};
+    template<> struct Cold_layout<events::Swing_damage_landed_support> : Cold_members<events::Swing_damage_landed_support,
+      &events::Swing_damage_landed_support::combat_header, &events::Swing_damage_landed_support::spell,
+      &events::Swing_damage_landed_support::advanced, &events::Swing_damage_landed_support::damage,
+      &events::Swing_damage_landed_support::supporter> {};
+    template<> struct Cold_layout<events::Spell_missed> : Cold_members<events::Spell_missed,
+      &events::Spell_missed::combat_header, &events::Spell_missed::spell,
+      &events::Spell_missed::type, &events::Spell_missed::offhand,
+      &events::Spell_missed::final, &events::Spell_missed::initial> {};
+    template<> struct Cold_layout<events::Spell_damage> : Cold_members<events::Spell_damage,
+      &events::Spell_damage::combat_header, &events::Spell_damage::spell,
+      &events::Spell_damage::advanced, &events::Spell_damage::damage> {};
+    template<> struct Cold_layout<events::Spell_damage_support> : Cold_members<events::Spell_damage_support,
+      &events::Spell_damage_support::combat_header, &events::Spell_damage_support::spell,
+      &events::Spell_damage_support::advanced, &events::Spell_damage_support::damage,
+      &events::Spell_damage_support::supporter> {};
+    template<> struct Cold_layout<events::Spell_heal> : Cold_members<events::Spell_heal,
+      &events::Spell_heal::combat_header, &events::Spell_heal::spell,
+      &events::Spell_heal::advanced, &events::Spell_heal::heal> {};
+    template<> struct Cold_layout<events::Spell_cast_success> : Cold_members<events::Spell_cast_success,
+      &events::Spell_cast_success::combat_header, &events::Spell_cast_success::spell,
+      &events::Spell_cast_success::advanced> {};
+    template<> struct Cold_layout<events::Spell_summon> : Cold_members<events::Spell_summon,
+      &events::Spell_summon::summoner, &events::Spell_summon::summoned,
+      &events::Spell_summon::spell> {};
+    template<> struct Cold_layout<events::Unit_died> : Cold_members<events::Unit_died,
+      &events::Unit_died::combat_header, &events::Unit_died::unconscious_on_death> {};
+    template<> struct Cold_layout<events::Spell_resurrect> : Cold_members<events::Spell_resurrect,
+      &events::Spell_resurrect::combat_header, &events::Spell_resurrect::spell> {};
+
+    //the fields of T not in the hot columns
+    template<typename T>
+    using Cold = typename Cold_layout<T>::Type;
+
+    template<typename T>
+    Cold<T> cold_of(T const& event) noexcept {
+      return Cold_layout<T>::split(event);
+    }
+
+    //an event put back together from its hot columns and cold fields. fields T doesn't
+    //have are ignored
+    template<typename T>
+    T rebuild(Cold<T> const& cold, Guid source, Guid dest, std::uint64_t spell, std::int64_t amount) noexcept {
+      T returning{};
+      Cold_layout<T>::restore(returning, cold);
+      if constexpr (has_units<T>) {
+        returning.combat_header.source.guid = source;
+        returning.combat_header.dest.guid = dest;
+      }
+      if constexpr (has_spell<T>) {
+        returning.spell.id = spell;
+      }
+      if constexpr (has_amount<T>) {
+        set_amount(returning, amount);
+      }
+      return returning;
+    }
+
+    template<typename T, typename Variant>
+    struct Index_in;
+
+    template<typename T, typename... Ts>
+    struct Index_in<T, std::variant<Ts...>> {
+      static constexpr std::array<bool, sizeof...(Ts)> SAME = { std::is_same_v<T, Ts>... };
+      //sizeof...(Ts) if T isn't one of them
+      static constexpr std::size_t VALUE = static_cast<std::size_t>(std::find(SAME.begin(), SAME.end(), true) - SAME.begin());
+    };
+  }
+
+  //one event type's events, as a column for each field scans usually want plus a column of
+  //the rest of each event's fields. source, dest, spell and amount stay empty for types
+  //without them
+  template<typename T>
+  struct Event_table {
+    std::vector<Timestamp> time;
+    std::vector<Unit_id> source;
+    std::vector<Unit_id> dest;
+    std::vector<std::uint64_t> spell;
+    std::vector<std::int64_t> amount;
+    std::vector<internal::Cold<T>> cold;
+
+    std::size_t size() const noexcept {
+      return time.size();
+    }
+  };
+
+  namespace internal {
+    template<typename Variant>
+    struct Tables_of;
+
+    template<typename... Ts>
+    struct Tables_of<std::variant<Ts...>> {
+      using Type = std::tuple<Event_table<Ts>...>;
+    };
+  }
+
+  //keeps each type of event in its own Event_table instead of one vector of variants, so a
+  //small event doesn't take up as much room as the largest one, and a scan only touches the
+  //columns it reads. order() gives back the order they were added in
+  template<typename Filter = All_events>
+  struct Columnar_log {
+  public:
+    using Types = typename Filter::Types;
+
+    struct Row {
+      std::uint8_t type; //index of the event's type in Types
+      std::uint32_t index; //into that type's table
+    };
+
+    auto parsing_cb() noexcept {
+      return [this]<typename T>(Timestamp time, T const& event, std::size_t)
+        requires (internal::Index_in<T, Types>::VALUE < std::variant_size_v<Types>) {
+        this->add(time, event);
+      };
+    }
+
+    template<typename T>
+    void add(Timestamp time, T const& event) {
+      Event_table<T>& table = std::get<Event_table<T>>(tables_);
+      order_.push_back(Row{
+        static_cast<std::uint8_t>(internal::Index_in<T, Types>::VALUE),
+        static_cast<std::uint32_t>(table.size()) });
+
+      table.time.push_back(time);
+      if constexpr (internal::has_units<T>) {
+        table.source.push_back(units_.id(event.combat_header.source.guid));
+        table.dest.push_back(units_.id(event.combat_header.dest.guid));
+      }
+      if constexpr (internal::has_spell<T>) {
+        table.spell.push_back(event.spell.id);
+      }
+      if constexpr (internal::has_amount<T>) {
+        table.amount.push_back(internal::amount_of(event));
+      }
+      table.cold.push_back(internal::cold_of(store_.get(event)));
+    }
+
+    //the event at index in T's table, put back together from its columns
+    template<typename T>
+    T event(std::uint32_t index) const noexcept {
+      Event_table<T> const& table = this->table<T>();
+      Guid source;
+      Guid dest;
+      if constexpr (internal::has_units<T>) {
+        source = units_[table.source[index]];
+        dest = units_[table.dest[index]];
+      }
+      return internal::rebuild<T>(table.cold[index], source, dest, spell_of_(table, index), amount_of_(table, index));
+    }
+
+    template<typename T>
+    Event_table<T> const& table() const noexcept {
+      return std::get<Event_table<T>>(tables_);
+    }
+    std::vector<Row> const& order() const noexcept {
+      return order_;
+    }
+    std::size_t size() const noexcept {
+      return order_.size();
+    }
+
+    Unit_table const& units() const noexcept {
+      return units_;
+    }
+
+    //visitor(time, event) for every event, in the order they were added
+    template<typename Visitor>
+    void for_each(Visitor&& visitor) const {
+      for_each_(visitor, std::make_index_sequence<std::variant_size_v<Types>>{});
+    }
+
+    void clear() {
+      tables_ = {};
+      order_.clear();
+      units_.clear();
+      store_.clear();
+    }
+  private:
+    template<typename T, typename Visitor>
+    static void visit_(Columnar_log const& log, Visitor& visitor, std::uint32_t index) {
+      visitor(log.table<T>().time[index], log.event<T>(index));
+    }
+
+    template<typename T>
+    static std::uint64_t spell_of_(Event_table<T> const& table, std::uint32_t index) noexcept {
+      if constexpr (internal::has_spell<T>) {
+        return table.spell[index];
+      } else {
+        return 0;
+      }
+    }
+    template<typename T>
+    static std::int64_t amount_of_(Event_table<T> const& table, std::uint32_t index) noexcept {
+      if constexpr (internal::has_amount<T>) {
+        return table.amount[index];
+      } else {
+        return 0;
+      }
+    }
+
+    template<typename Visitor, std::size_t... Is>
+    void for_each_(Visitor& visitor, std::index_sequence<Is...>) const {
+      using Handler = void(*)(Columnar_log const&, Visitor&, std::uint32_t);
+      static constexpr std::array<Handler, sizeof...(Is)> HANDLERS = { &visit_<std::variant_alternative_t<Is, Types>, Visitor>... };
+
+      for (Row const& row : order_) {
+        HANDLERS[row.type](*this, visitor, row.index);
+      }
+    }
+
+    typename internal::Tables_of<Types>::Type tables_;
+    std::vector<Row> order_;
+    Unit_table units_;
+    String_store store_;
+  };
+}
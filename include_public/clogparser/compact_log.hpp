@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <clogparser/parser.hpp>
+#include <clogparser/columnar_log.hpp>
+#include <clogparser/payload_arena.hpp>
+
+namespace clogparser {
+  //a fixed size record of the fields most scans need. the rest of the event's fields are in
+  //its log's payload arena
+  struct Compact_event {
+    static constexpr Unit_id NO_UNIT = std::numeric_limits<Unit_id>::max();
+
+    std::int64_t time; //Timestamp::since_epoch() in ms
+    std::int64_t amount; //the damage, healing or absorb, 0 for events without one
+    Payload_arena::Offset payload; //the event's fields that aren't in here
+    Unit_id source; //NO_UNIT for events without a combat header
+    Unit_id dest;
+    std::uint32_t spell; //0 for events without a spell. spell ids fit in 32 bits, so it's the low 32 of Spell_info::id
+    std::uint8_t type; //index of the event's type in its log's Types
+
+    Timestamp timestamp() const noexcept {
+      return Timestamp::from_epoch(Period{ time });
+    }
+  };
+  static_assert(sizeof(Compact_event) == 40);
+
+  //a Log of Compact_events in the order they were added, so memory is 40 bytes an event
+  //plus the rest of each event's fields packed at their own size, instead of each one
+  //taking the room of the largest event type. times need the timestamps' years to be known
+  //to compare across new year
+  template<typename Filter = All_events>
+  struct Compact_log {
+  public:
+    using Types = typename Filter::Types;
+
+    auto parsing_cb() noexcept {
+      return [this]<typename T>(Timestamp time, T const& event, std::size_t)
+        requires (internal::Index_in<T, Types>::VALUE < std::variant_size_v<Types>) {
+        this->add(time, event);
+      };
+    }
+
+    template<typename T>
+    void add(Timestamp time, T const& event) {
+      Compact_event adding{
+        time.since_epoch().count(),
+        0,
+        payloads_.push(internal::cold_of(store_.get(event))),
+        Compact_event::NO_UNIT,
+        Compact_event::NO_UNIT,
+        0,
+        static_cast<std::uint8_t>(internal::Index_in<T, Types>::VALUE)
+      };
+      if constexpr (internal::has_units<T>) {
+        adding.source = units_.id(event.combat_header.source.guid);
+        adding.dest = units_.id(event.combat_header.dest.guid);
+      }
+      if constexpr (internal::has_spell<T>) {
+        adding.spell = static_cast<std::uint32_t>(event.spell.id);
+      }
+      if constexpr (internal::has_amount<T>) {
+        adding.amount = internal::amount_of(event);
+      }
+      events_.push_back(adding);
+    }
+
+    std::vector<Compact_event> const& events() const noexcept {
+      return events_;
+    }
+
+    //event has to be one of this log's, holding a T, which is put back together from it
+    //and its payload
+    template<typename T>
+    T get(Compact_event const& event) const noexcept {
+      Guid source;
+      Guid dest;
+      if constexpr (internal::has_units<T>) {
+        source = units_[event.source];
+        dest = units_[event.dest];
+      }
+      return internal::rebuild<T>(payloads_.get<internal::Cold<T>>(event.payload), source, dest, event.spell, event.amount);
+    }
+
+    Types decode(Compact_event const& event) const {
+      return decode_(event, std::make_index_sequence<std::variant_size_v<Types>>{});
+    }
+
+    //visitor(time, event) for every event, in the order they were added
+    template<typename Visitor>
+    void for_each(Visitor&& visitor) const {
+      for_each_(visitor, std::make_index_sequence<std::variant_size_v<Types>>{});
+    }
+
+    Unit_table const& units() const noexcept {
+      return units_;
+    }
+
+    void clear() {
+      events_.clear();
+      payloads_.clear();
+      units_.clear();
+      store_.clear();
+    }
+  private:
+    template<std::size_t... Is>
+    Types decode_(Compact_event const& event, std::index_sequence<Is...>) const {
+      using Handler = Types(*)(Compact_log const&, Compact_event const&);
+      static constexpr std::array<Handler, sizeof...(Is)> HANDLERS = {
+        [](Compact_log const& log, Compact_event const& event) -> Types {
+          return Types{ std::in_place_index<Is>, log.get<std::variant_alternative_t<Is, Types>>(event) };
+        }...
+      };
+      return HANDLERS[event.type](*this, event);
+    }
+
+    template<typename T, typename Visitor>
+    static void visit_(Compact_log const& log, Visitor& visitor, Compact_event const& event) {
+      visitor(event.timestamp(), log.get<T>(event));
+    }
+
+    template<typename Visitor, std::size_t... Is>
+    void for_each_(Visitor& visitor, std::index_sequence<Is...>) const {
+      using Handler = void(*)(Compact_log const&, Visitor&, Compact_event const&);
+      static constexpr std::array<Handler, sizeof...(Is)> HANDLERS = { &visit_<std::variant_alternative_t<Is, Types>, Visitor>... };
+
+      for (Compact_event const& event : events_) {
+        HANDLERS[event.type](*this, visitor, event);
+      }
+    }
+
+    std::vector<Compact_event> events_;
+    Payload_arena payloads_;
+    Unit_table units_;
+    String_store store_;
+  };
+}
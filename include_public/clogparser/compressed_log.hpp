@@ -0,0 +1,86 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <clogparser/parser.hpp>
+
+namespace clogparser {
+  namespace internal {
+    struct Log_source;
+  }
+
+  enum class Compression {
+    none,
+    gzip,
+    zstd
+  };
+
+  //from the magic number at the start of a file
+  Compression compression_of(std::string_view start) noexcept;
+
+  //whether this build can decompress compression
+  bool can_decompress(Compression compression) noexcept;
+
+  //a log decompressed on a thread of its own into a ring of reusable buffers, handed out in
+  //order. each buffer holds only whole lines, so none straddle two buffers. uncompressed
+  //files are read through the same way
+  struct Decompressed_log {
+  public:
+    static constexpr std::size_t DEFAULT_BUFFER_SIZE = std::size_t{ 4 } << 20;
+    static constexpr std::size_t DEFAULT_BUFFERS = 4;
+
+    //throws std::system_error if path can't be opened, and std::runtime_error if its
+    //compression isn't supported by this build
+    explicit Decompressed_log(std::filesystem::path const& path, std::size_t buffer_size = DEFAULT_BUFFER_SIZE, std::size_t buffers = DEFAULT_BUFFERS);
+
+    Decompressed_log(Decompressed_log const&) = delete;
+    Decompressed_log& operator=(Decompressed_log const&) = delete;
+
+    ~Decompressed_log();
+
+    //the next buffer of lines, valid until the next call. empty once all of the log has been
+    //handed out. throws std::runtime_error if the log couldn't be read or decompressed
+    std::string_view next();
+  private:
+    void decompress_();
+
+    std::unique_ptr<internal::Log_source> source_;
+    std::size_t buffer_size_;
+    std::vector<std::string> buffers_;
+    std::vector<std::size_t> sizes_; //of the lines in each buffer
+    std::deque<std::size_t> free_;
+    std::deque<std::size_t> filled_;
+    std::size_t handed_out_; //buffers_.size() when none is
+    bool done_ = false;
+    bool stopping_ = false;
+    std::exception_ptr error_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::thread thread_;
+  };
+
+  //parses a log that may be compressed without decompressing it to disk first. offsets handed
+  //to cb are into the decompressed log, and views only last for the call. timestamps get
+  //their year from the date in the file name when it has one
+  template<typename Filter = All_events, typename Cb>
+  void parse_compressed(std::filesystem::path const& path, Cb&& cb) {
+    const auto log_start = log_file_date(path.filename().string());
+    Parser<Cb, Filter> parser{ std::forward<Cb>(cb), log_start ? Timestamp_decoder{ *log_start } : Timestamp_decoder{} };
+    Decompressed_log log{ path };
+    std::size_t offset = 0;
+    for (std::string_view lines = log.next(); !lines.empty(); lines = log.next()) {
+      parser.parse_all(lines, offset);
+      offset += lines.size();
+    }
+  }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <clogparser/parser.hpp>
+#include <clogparser/mapped_log.hpp>
+
+namespace clogparser {
+  //where each pull, zone change and log version line is in a log, so one pull can be parsed
+  //on its own with parse_pull
+  struct Encounter_index {
+    static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+    struct Version {
+      std::uint64_t offset; //of its line
+      events::Combat_log_version version;
+    };
+
+    struct Zone {
+      std::uint64_t offset; //of its line
+      std::uint64_t instance_id;
+      std::string name;
+      std::uint64_t difficulty_id;
+    };
+
+    struct Pull {
+      std::uint64_t begin; //offset of its ENCOUNTER_START line
+      std::uint64_t end; //one past its ENCOUNTER_END line, or the end of the log if it never ended
+      Timestamp start_time;
+      Timestamp end_time; //same as start_time if it never ended
+      std::int32_t encounter_id;
+      std::string name;
+      Difficulty difficulty_id;
+      std::uint8_t instance_size;
+      std::uint64_t instance_id;
+      bool ended;
+      bool success;
+      std::size_t zone; //index into zones of the last zone change before it, or NONE
+      std::size_t version; //index into versions of the last log version before it, or NONE
+    };
+
+    std::uint64_t log_size = 0;
+    std::uint64_t log_start = 0; //internal::hash_start of the log
+    std::vector<Version> versions;
+    std::vector<Zone> zones;
+    std::vector<Pull> pulls;
+  };
+
+  Encounter_index index_encounters(std::string_view log, Timestamp_decoder timestamps = {});
+
+  //throws std::system_error if path can't be written
+  void write_index(std::filesystem::path const& path, Encounter_index const& index);
+  //nullopt if path is missing, or isn't an index written by this version
+  std::optional<Encounter_index> read_index(std::filesystem::path const& path);
+
+  //the index of log, which was mapped from path. it's kept next to it in path.encounters,
+  //which is written again when it's missing or out of date. keeping it is best effort, a
+  //log in a directory that can't be written to is indexed again each time
+  Encounter_index index_file(std::filesystem::path const& path, Mapped_log const& log);
+
+  template<typename Filter = All_events, typename Cb>
+  void parse_pull(Mapped_log const& log, Encounter_index::Pull const& pull, Cb&& cb, Timestamp_decoder timestamps) {
+    parse_range<Filter>(log, pull.begin, pull.end, std::forward<Cb>(cb), timestamps);
+  }
+  //timestamps get their years from the pull's start, as they did when it was indexed
+  template<typename Filter = All_events, typename Cb>
+  void parse_pull(Mapped_log const& log, Encounter_index::Pull const& pull, Cb&& cb) {
+    parse_pull<Filter>(log, pull, std::forward<Cb>(cb), Timestamp_decoder::starting_at(pull.start_time));
+  }
+}
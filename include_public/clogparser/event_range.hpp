@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+#include <clogparser/parser.hpp>
+#include <clogparser/mapped_log.hpp>
+#include <clogparser/generator.hpp>
+
+namespace clogparser {
+  //an event pulled from a log. its views point into the log like those handed to a
+  //callback, and a COMBATANT_INFO's arrays into the puller's arena
+  template<typename Types = events::Type>
+  struct Basic_event_ref {
+    Timestamp time;
+    Types event;
+    std::size_t offset; //of the event's line in the log
+  };
+
+  using Event_ref = Basic_event_ref<>;
+
+  //the events of a complete log pulled a few at a time, for (auto const& event : range).
+  //lines are parsed as the range is iterated into a small buffer, so nothing is allocated
+  //per event. an event is valid until the iterator passes it, and lines that fail to parse
+  //are skipped
+  template<typename Filter = All_events>
+  struct Event_range {
+  public:
+    using Ref = Basic_event_ref<typename Filter::Types>;
+
+    static constexpr std::size_t BUFFER_SIZE = 64;
+
+    explicit Event_range(std::string_view log, Timestamp_decoder timestamps = {}, std::size_t offset = 0) :
+      rest_(log),
+      parser_(Sink{ this }, timestamps) {
+      parser_.reset(timestamps, offset);
+    }
+
+    //the parser points back at the range
+    Event_range(Event_range const&) = delete;
+    Event_range& operator=(Event_range const&) = delete;
+
+    struct Sentinel {};
+
+    struct Iterator {
+    public:
+      using value_type = Ref;
+      using difference_type = std::ptrdiff_t;
+
+      Iterator() = default;
+      explicit Iterator(Event_range* range) noexcept :
+        range_(range) {
+
+      }
+
+      Ref const& operator*() const noexcept {
+        return range_->buffer_[range_->on_];
+      }
+      Ref const* operator->() const noexcept {
+        return &**this;
+      }
+
+      Iterator& operator++() {
+        if (++range_->on_ == range_->size_) {
+          range_->refill_();
+        }
+        return *this;
+      }
+      void operator++(int) {
+        ++*this;
+      }
+
+      friend bool operator==(Iterator const& iterator, Sentinel) noexcept {
+        return iterator.done_();
+      }
+    private:
+      bool done_() const noexcept {
+        return range_->on_ == range_->size_;
+      }
+
+      Event_range* range_ = nullptr;
+    };
+
+    //parses up to the first event, so iterating starts where the last iteration stopped
+    Iterator begin() {
+      if (on_ == size_) {
+        refill_();
+      }
+      return Iterator{ this };
+    }
+    Sentinel end() const noexcept {
+      return {};
+    }
+
+    //carries on with more of the log once every event before it has been pulled. more
+    //has to start at the start of a line, and the views in its events point into it
+    void append(std::string_view more) noexcept {
+      rest_ = more;
+    }
+  private:
+    struct Sink {
+      template<typename T> requires std::is_constructible_v<typename Filter::Types, T>
+      void operator()(Timestamp time, T const& event, std::size_t offset) {
+        range->buffer_[range->size_++] = Ref{ time, typename Filter::Types{ std::in_place_type<T>, event }, offset };
+        //the next of these would reuse the arena this one's arrays are in
+        range->full_ = range->size_ == BUFFER_SIZE || internal::uses_arena<T>;
+      }
+
+      Event_range* range;
+    };
+
+    void refill_() {
+      on_ = 0;
+      size_ = 0;
+      full_ = false;
+      rest_ = parser_.parse_until(rest_, [this]() noexcept { return full_; });
+    }
+
+    std::string_view rest_;
+    Parser<Sink, Filter> parser_;
+    std::array<Ref, BUFFER_SIZE> buffer_;
+    std::size_t on_ = 0; //being pulled
+    std::size_t size_ = 0;
+    bool full_ = false;
+  };
+
+  //the events of log, pulled as the range is iterated
+  template<typename Filter = All_events>
+  Event_range<Filter> events_in(std::string_view log, Timestamp_decoder timestamps = {}) {
+    return Event_range<Filter>{ log, timestamps };
+  }
+  template<typename Filter = All_events>
+  Event_range<Filter> events_in(Mapped_log const& log, Timestamp_decoder timestamps = {}) {
+    return Event_range<Filter>{ log.data(), timestamps };
+  }
+  //the events' views would outlive the mapping
+  template<typename Filter = All_events>
+  Event_range<Filter> events_in(Mapped_log&& log, Timestamp_decoder timestamps = {}) = delete;
+
+  //the events of every chunk source.next() returns until an empty one. each chunk has to
+  //be whole lines and stay valid until next() is called again, as Decompressed_log's are
+  template<typename Filter = All_events, typename Source>
+  Generator<Basic_event_ref<typename Filter::Types>> events_from(Source& source, Timestamp_decoder timestamps = {}) {
+    Event_range<Filter> range{ {}, timestamps };
+    for (std::string_view chunk; !(chunk = source.next()).empty();) {
+      range.append(chunk);
+      for (auto const& event : range) {
+        co_yield event;
+      }
+    }
+  }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace clogparser {
+  //a coroutine yielding Ts one at a time, each viewed in place rather than copied out. a
+  //yielded T is valid until the generator is resumed. the coroutine's frame is its only
+  //allocation
+  template<typename T>
+  struct Generator {
+  public:
+    struct promise_type {
+      Generator get_return_object() noexcept {
+        return Generator{ std::coroutine_handle<promise_type>::from_promise(*this) };
+      }
+      std::suspend_always initial_suspend() noexcept {
+        return {};
+      }
+      std::suspend_always final_suspend() noexcept {
+        return {};
+      }
+      std::suspend_always yield_value(T const& value) noexcept {
+        yielded = std::addressof(value);
+        return {};
+      }
+      void return_void() noexcept {
+
+      }
+      void unhandled_exception() noexcept {
+        error = std::current_exception();
+      }
+
+      T const* yielded = nullptr;
+      std::exception_ptr error;
+    };
+
+    struct Sentinel {};
+
+    struct Iterator {
+    public:
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+
+      Iterator() = default;
+      explicit Iterator(std::coroutine_handle<promise_type> coroutine) noexcept :
+        coroutine_(coroutine) {
+
+      }
+
+      T const& operator*() const noexcept {
+        return *coroutine_.promise().yielded;
+      }
+      T const* operator->() const noexcept {
+        return coroutine_.promise().yielded;
+      }
+
+      Iterator& operator++() {
+        resume(coroutine_);
+        return *this;
+      }
+      void operator++(int) {
+        ++*this;
+      }
+
+      friend bool operator==(Iterator const& iterator, Sentinel) noexcept {
+        return iterator.coroutine_.done();
+      }
+    private:
+      std::coroutine_handle<promise_type> coroutine_;
+    };
+
+    Generator(Generator&& other) noexcept :
+      coroutine_(std::exchange(other.coroutine_, nullptr)) {
+
+    }
+    Generator& operator=(Generator other) noexcept {
+      std::swap(coroutine_, other.coroutine_);
+      return *this;
+    }
+    ~Generator() {
+      if (coroutine_) {
+        coroutine_.destroy();
+      }
+    }
+
+    //runs the coroutine to its first yield, so it can only be called once
+    Iterator begin() {
+      resume(coroutine_);
+      return Iterator{ coroutine_ };
+    }
+    Sentinel end() const noexcept {
+      return {};
+    }
+  private:
+    explicit Generator(std::coroutine_handle<promise_type> coroutine) noexcept :
+      coroutine_(coroutine) {
+
+    }
+
+    //exceptions thrown by the coroutine come out of begin() or ++
+    static void resume(std::coroutine_handle<promise_type> coroutine) {
+      coroutine.resume();
+      if (coroutine.promise().error) {
+        std::rethrow_exception(std::exchange(coroutine.promise().error, nullptr));
+      }
+    }
+
+    std::coroutine_handle<promise_type> coroutine_;
+  };
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <compare>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace clogparser {
+  //a unit, item or cast guid packed into 128 bits, so comparing and hashing them is a couple
+  //of integer ops. the fields are named after their parts in
+  //  Player-[server_id]-[spawn_uid]
+  //  Creature-[subtype]-[server_id]-[instance_id]-[zone_uid]-[id]-[spawn_uid]
+  //  Item-[server_id]-[subtype]-[spawn_uid]
+  //  BattlePet-[subtype]-[spawn_uid]
+  //Pet, GameObject, Vehicle, Vignette, AreaTrigger and Cast guids are laid out like Creature's.
+  //any other guid is an unknown one, which only keeps a hash of its text
+  struct Guid {
+  public:
+    enum class Type : std::uint8_t {
+      none, //0000000000000000
+      player,
+      creature,
+      pet,
+      game_object,
+      vehicle,
+      vignette,
+      area_trigger,
+      cast,
+      item,
+      battle_pet,
+      unknown //none of the above, see opaque()
+    };
+
+    constexpr Guid() noexcept = default;
+    //from another guid's hi() and lo()
+    constexpr Guid(std::uint64_t hi, std::uint64_t lo) noexcept :
+      hi_(hi),
+      lo_(lo) {
+
+    }
+
+    //nullopt when in isn't one of the shapes above, or a field doesn't fit its bits. a parsed
+    //guid prints back as in, other than an empty one printing as 0000000000000000
+    static std::optional<Guid> parse(std::string_view in) noexcept;
+    //an unknown guid from a 122 bit hash of in, so guids with the same text are equal. its
+    //fields other than type() mean nothing, and it prints as Unknown- and the hash
+    static Guid opaque(std::string_view in) noexcept;
+
+    constexpr Type type() const noexcept {
+      return static_cast<Type>(hi_ >> TYPE_SHIFT);
+    }
+    constexpr std::uint8_t subtype() const noexcept {
+      return static_cast<std::uint8_t>((hi_ >> SUBTYPE_SHIFT) & SUBTYPE_MASK);
+    }
+    constexpr std::uint16_t server_id() const noexcept {
+      return static_cast<std::uint16_t>((hi_ >> SERVER_ID_SHIFT) & SERVER_ID_MASK);
+    }
+    constexpr std::uint16_t instance_id() const noexcept {
+      return static_cast<std::uint16_t>((hi_ >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK);
+    }
+    constexpr std::uint32_t zone_uid() const noexcept {
+      return static_cast<std::uint32_t>(lo_ >> ZONE_UID_SHIFT);
+    }
+    //the npc, object or spell id
+    constexpr std::uint32_t id() const noexcept {
+      return static_cast<std::uint32_t>(hi_ & ID_MASK);
+    }
+    constexpr std::uint64_t spawn_uid() const noexcept {
+      return has_zone_() ? (lo_ & SPAWN_UID_MASK) : lo_;
+    }
+
+    constexpr std::uint64_t hi() const noexcept {
+      return hi_;
+    }
+    constexpr std::uint64_t lo() const noexcept {
+      return lo_;
+    }
+
+    constexpr bool operator==(Guid const&) const noexcept = default;
+    constexpr std::strong_ordering operator<=>(Guid const&) const noexcept = default;
+
+    static constexpr unsigned TYPE_SHIFT = 58;
+    static constexpr unsigned SUBTYPE_SHIFT = 52;
+    static constexpr std::uint64_t SUBTYPE_MASK = 0x3F;
+    static constexpr unsigned SERVER_ID_SHIFT = 39;
+    static constexpr std::uint64_t SERVER_ID_MASK = 0x1FFF;
+    static constexpr unsigned INSTANCE_ID_SHIFT = 25;
+    static constexpr std::uint64_t INSTANCE_ID_MASK = 0x3FFF;
+    static constexpr std::uint64_t ID_MASK = 0x1FFFFFF;
+    static constexpr unsigned ZONE_UID_SHIFT = 40;
+    static constexpr std::uint64_t SPAWN_UID_MASK = 0xFFFFFFFFFF;
+  private:
+    constexpr bool has_zone_() const noexcept {
+      const Type t = type();
+      return t != Type::player && t != Type::item && t != Type::battle_pet && t != Type::unknown;
+    }
+
+    std::uint64_t hi_ = 0;
+    std::uint64_t lo_ = 0;
+  };
+
+  std::string to_string(Guid guid);
+}
+
+template<>
+struct std::hash<clogparser::Guid> {
+  std::size_t operator()(clogparser::Guid const& guid) const noexcept {
+    const std::uint64_t mixed = (guid.hi() * 0x9E3779B97F4A7C15) ^ guid.lo();
+    return static_cast<std::size_t>(mixed ^ (mixed >> 29));
+  }
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace clogparser {
+  //copies each unique string once into large blocks, found again through an open addressing
+  //table. the views and ids it hands out stay valid until clear(), even if it's moved
+  struct Interner {
+  public:
+    using Id = std::uint32_t;
+
+    struct Interned {
+      std::string_view str;
+      Id id; //dense, the nth unique string interned gets n
+    };
+
+    Interned intern(std::string_view in);
+    //hash has to be hash(in)
+    Interned intern(std::string_view in, std::uint32_t hash);
+    std::optional<Id> find(std::string_view in) const noexcept;
+
+    std::string_view operator[](Id id) const noexcept {
+      return strings_[id];
+    }
+    std::size_t size() const noexcept {
+      return strings_.size();
+    }
+
+    void clear() noexcept;
+
+    static std::uint32_t hash(std::string_view in) noexcept;
+  private:
+    struct Entry {
+      std::uint32_t hash;
+      Id id_plus_one; //0 for an empty entry
+    };
+
+    static constexpr std::size_t BLOCK_SIZE = std::size_t{ 64 } << 10;
+
+    std::size_t find_slot_(std::string_view in, std::uint32_t hash) const noexcept;
+    char const* copy_(std::string_view in);
+    void grow_();
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* block_on_ = nullptr;
+    std::size_t block_left_ = 0;
+    std::vector<std::string_view> strings_;
+    std::vector<Entry> table_;
+  };
+
+  //an Interner parser threads can share. strings are spread over shards by hash, each shard
+  //behind its own lock, and every thread keeps a small cache of the strings it saw last so
+  //hot ones like player guids don't take a lock. views stay valid until clear(), which
+  //mustn't run while another thread is interning
+  struct Concurrent_interner {
+  public:
+    //rounded up to a power of 2, at most 256
+    explicit Concurrent_interner(std::size_t shards = 16);
+
+    Concurrent_interner(Concurrent_interner const&) = delete;
+    Concurrent_interner& operator=(Concurrent_interner const&) = delete;
+
+    std::string_view intern(std::string_view in);
+
+    std::size_t size() const;
+    void clear();
+  private:
+    struct Shard {
+      std::mutex mutex;
+      Interner strings;
+    };
+
+    Shard& shard_(std::uint32_t hash) noexcept;
+
+    std::unique_ptr<Shard[]> shards_;
+    unsigned shard_bits_;
+    //unique to this store until it's cleared, so thread caches never mix up stores
+    std::uint64_t generation_;
+  };
+}
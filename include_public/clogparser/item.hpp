@@ -2,7 +2,7 @@
 
 #include <cstdint>
 #include <optional>
-#include <vector>
+#include <span>
 
 namespace clogparser {
   enum class Item_slot : std::uint8_t {
@@ -35,13 +35,14 @@ namespace clogparser {
     ranged_2 = 26
   };
 
+  //bonus_ids and gem_ids view the arrays the Item was decoded into, see Combatant_info
   struct Item {
     std::uint64_t item_id;
     std::uint16_t ilvl;
     std::optional<std::uint64_t> permanent_enchant_id;
     std::optional<std::uint64_t> temp_enchant_id;
     std::optional<std::uint64_t> on_use_spell_enchant_id;
-    std::vector<std::uint64_t> bonus_ids;
-    std::vector<std::uint64_t> gem_ids;
+    std::span<const std::uint64_t> bonus_ids;
+    std::span<const std::uint64_t> gem_ids;
   };
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <clogparser/parser.hpp>
+
+namespace clogparser {
+  //the newest WoWCombatLog*.txt in a directory, read as it's appended to. a newer log
+  //showing up, or the log being truncated or replaced, starts it over from that log's start
+  struct Log_tail {
+  public:
+    enum class Start {
+      beginning, //read what's already in the log
+      end //only read what's appended after it's opened
+    };
+
+    struct Read {
+      std::string_view data; //valid until the next read
+      std::uint64_t offset; //of data in the log
+      bool restarted; //data is from another log than the last read, or the same one after it was truncated
+    };
+
+    //throws std::system_error if directory can't be watched
+    explicit Log_tail(std::filesystem::path directory, Start start = Start::beginning);
+
+    Log_tail(Log_tail const&) = delete;
+    Log_tail& operator=(Log_tail const&) = delete;
+
+    ~Log_tail();
+
+    //blocks until something in the directory changes, or timeout passes
+    void wait(std::chrono::milliseconds timeout);
+
+    //what was appended since the last read, at most a buffer at a time. data is empty once
+    //it's caught up. throws std::system_error if the log can't be read
+    Read read();
+
+    //the log being read, empty until there is one
+    std::filesystem::path const& path() const noexcept {
+      return path_;
+    }
+  private:
+    void open_newest_();
+    std::uint64_t size_() const;
+    std::size_t read_at_(std::uint64_t offset, std::size_t size);
+    bool is_open_() const noexcept;
+    void close_() noexcept;
+
+    std::filesystem::path directory_;
+    std::filesystem::path path_;
+    Start start_;
+    std::uint64_t offset_ = 0;
+    bool rescan_ = true;
+    bool restarted_ = false;
+    std::vector<char> buffer_;
+#ifdef _WIN32
+    void* file_ = nullptr;
+#else
+    int file_ = -1;
+    int watch_ = -1;
+#endif
+  };
+
+  //parses the newest WoWCombatLog*.txt in a directory as it's written. as with Parser::parse
+  //the views handed to cb only last for the call, and offsets are into the current log
+  template<typename Cb, typename Filter = All_events>
+  struct Log_follower {
+  public:
+    Log_follower(std::filesystem::path directory, Cb cb, Log_tail::Start start = Log_tail::Start::beginning) :
+      tail_(std::move(directory), start),
+      parser_(std::forward<Cb>(cb)) {
+
+    }
+
+    //parses what has been appended, waiting up to timeout for more if nothing was.
+    //returns how many bytes were parsed
+    std::size_t poll(std::chrono::milliseconds timeout) {
+      std::size_t parsed = parse_appended_();
+      if (parsed == 0) {
+        tail_.wait(timeout);
+        parsed = parse_appended_();
+      }
+      return parsed;
+    }
+
+    std::filesystem::path const& path() const noexcept {
+      return tail_.path();
+    }
+  private:
+    std::size_t parse_appended_() {
+      std::size_t parsed = 0;
+      for (;;) {
+        const Log_tail::Read read = tail_.read();
+        if (read.restarted) {
+          const auto log_start = log_file_date(tail_.path().filename().string());
+          parser_.reset(log_start ? Timestamp_decoder{ *log_start } : Timestamp_decoder{}, static_cast<std::size_t>(read.offset));
+        }
+        if (read.data.empty()) {
+          return parsed;
+        }
+        parser_.parse(read.data);
+        parsed += read.data.size();
+      }
+    }
+
+    Log_tail tail_;
+    Parser<Cb, Filter> parser_;
+  };
+}
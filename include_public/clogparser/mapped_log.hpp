@@ -0,0 +1,71 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+#include <clogparser/parser.hpp>
+
+namespace clogparser {
+  //a combat log mapped read only into memory. views into data() stay valid for the life of the mapping
+  struct Mapped_log {
+  public:
+    explicit Mapped_log(std::filesystem::path const& path);
+
+    Mapped_log(Mapped_log const&) = delete;
+    Mapped_log(Mapped_log&& other) noexcept;
+
+    Mapped_log& operator=(Mapped_log const&) = delete;
+    Mapped_log& operator=(Mapped_log&& other) noexcept;
+
+    ~Mapped_log();
+
+    std::string_view data() const noexcept {
+      return { data_, size_ };
+    }
+    std::size_t size() const noexcept {
+      return size_;
+    }
+  private:
+    void close_() noexcept;
+
+    char const* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+  };
+
+  namespace internal {
+    //a hash of the start of log, which files made from a log keep with its size to tell if
+    //they're still of the same log
+    std::uint64_t hash_start(std::string_view log) noexcept;
+  }
+
+  //the views handed to cb point into log, not into a copy
+  template<typename Filter = All_events, typename Cb>
+  void parse(Mapped_log const& log, Cb&& cb, Timestamp_decoder timestamps = {}) {
+    Parser<Cb, Filter> parser{ std::forward<Cb>(cb), timestamps };
+    parser.parse_all(log.data());
+  }
+
+  //parses only [begin, end) of log, which have to be the starts of lines or its end. the
+  //offsets handed to cb are still from the start of log
+  template<typename Filter = All_events, typename Cb>
+  void parse_range(Mapped_log const& log, std::size_t begin, std::size_t end, Cb&& cb, Timestamp_decoder timestamps = {}) {
+    Parser<Cb, Filter> parser{ std::forward<Cb>(cb), timestamps };
+    parser.parse_all(log.data().substr(begin, end - begin), begin);
+  }
+
+  //maps path and parses all of it, the returned mapping keeps the views handed to cb alive.
+  //timestamps get their year from the date in the file name when it has one
+  template<typename Filter = All_events, typename Cb>
+  Mapped_log parse_file(std::filesystem::path const& path, Cb&& cb) {
+    Mapped_log log{ path };
+    const auto log_start = log_file_date(path.filename().string());
+    parse<Filter>(log, std::forward<Cb>(cb), log_start ? Timestamp_decoder{ *log_start } : Timestamp_decoder{});
+    return log;
+  }
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <limits>
+#include <array>
+#include <bit>
+
+//fast paths for the numbers in combat log columns. each returns false instead of
+//guessing when in isn't in the simple form it handles, so the caller can fall back
+//to std::from_chars and get the same result
+namespace clogparser {
+  namespace helpers {
+    namespace swar {
+      constexpr std::uint64_t ONES = 0x0101010101010101;
+      constexpr std::uint64_t HIGHS = ONES * 0x80;
+      constexpr std::uint64_t ZEROS = ONES * '0';
+
+      constexpr bool ENABLED = std::endian::native == std::endian::little;
+
+      inline std::uint64_t load(char const* in) noexcept {
+        std::uint64_t returning;
+        std::memcpy(&returning, in, sizeof(returning));
+        return returning;
+      }
+
+      //the 8 bytes ending at end with the first skip of them replaced by '0's, which
+      //leaves the value of the digits after them the same
+      inline std::uint64_t load_last(char const* end, std::size_t skip) noexcept {
+        const std::uint64_t chunk = load(end - 8);
+        if (skip == 0) {
+          return chunk;
+        }
+        const std::uint64_t skipped = ~std::uint64_t(0) >> (8 * (8 - skip));
+        return (chunk & ~skipped) | (ZEROS & skipped);
+      }
+
+      //0x80 in each byte that's between lo and hi, for bytes below 0x80
+      constexpr std::uint64_t in_range(std::uint64_t chunk, std::uint8_t lo, std::uint8_t hi) noexcept {
+        const std::uint64_t at_least_lo = chunk + ONES * (0x80 - lo);
+        const std::uint64_t above_hi = chunk + ONES * (0x7F - hi);
+        return at_least_lo & ~above_hi & HIGHS;
+      }
+
+      constexpr bool is_8_digits(std::uint64_t chunk) noexcept {
+        return ((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + ONES * 0x06) & 0xF0F0F0F0F0F0F0F0) >> 4)) == ONES * 0x33;
+      }
+
+      //pairs, then quads, then the whole 8 digits, first digit most significant
+      constexpr std::uint32_t parse_8_digits(std::uint64_t chunk) noexcept {
+        chunk = ((chunk & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+        chunk = ((chunk & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+        return static_cast<std::uint32_t>(((chunk & 0x0000FFFF0000FFFF) * 42949672960001) >> 32);
+      }
+
+      constexpr std::uint64_t letters(std::uint64_t chunk) noexcept {
+        return in_range(chunk | (ONES * 0x20), 'a', 'f');
+      }
+
+      constexpr bool is_8_hex_digits(std::uint64_t chunk) noexcept {
+        if ((chunk & HIGHS) != 0) {
+          return false;
+        }
+        return (in_range(chunk, '0', '9') | letters(chunk)) == HIGHS;
+      }
+
+      constexpr std::uint32_t parse_8_hex_digits(std::uint64_t chunk) noexcept {
+        const std::uint64_t nibbles = (chunk & (ONES * 0x0F)) + (letters(chunk) >> 7) * 9;
+        //each 16 bit lane holds the byte its two digits make, most significant lane lowest
+        std::uint64_t bytes = ((nibbles & 0x000F000F000F000F) << 4) | ((nibbles >> 8) & 0x000F000F000F000F);
+        bytes = (bytes | (bytes >> 8)) & 0x0000FFFF0000FFFF;
+        const auto in_order = static_cast<std::uint32_t>(bytes | (bytes >> 16));
+        return (in_order << 24) | ((in_order & 0xFF00) << 8) | ((in_order >> 8) & 0xFF00) | (in_order >> 24);
+      }
+
+      constexpr std::array<std::uint64_t, 9> POW10 = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+      };
+    }
+
+    //the digits of in from start on. numbers of 8 or more bytes, counting anything before
+    //start, are read 8 digits at a time with loads ending at the last digit, shorter ones
+    //a digit at a time
+    inline bool parse_decimal(std::string_view in, std::size_t start, std::uint64_t& returning) noexcept {
+      const std::size_t digits = in.size() - start;
+      if (digits == 0 || digits > 19) {
+        return false;
+      }
+      std::uint64_t value = 0;
+      if (in.size() < 8 || digits > 16) {
+        for (char c : in.substr(start)) {
+          const unsigned digit = static_cast<unsigned char>(c) - static_cast<unsigned>('0');
+          if (digit > 9) {
+            return false;
+          }
+          value = value * 10 + digit;
+        }
+      } else {
+        char const* end = in.data() + in.size();
+        if (digits > 8) {
+          const std::uint64_t high = swar::load(in.data() + start);
+          if (!swar::is_8_digits(high)) {
+            return false;
+          }
+          value = swar::parse_8_digits(high) * swar::POW10[digits - 8];
+        }
+        const std::uint64_t low = swar::load_last(end, digits > 8 ? 16 - digits : 8 - digits);
+        if (!swar::is_8_digits(low)) {
+          return false;
+        }
+        value += swar::parse_8_digits(low);
+      }
+      returning = value;
+      return true;
+    }
+
+    //hex digits of in from start on, at most 16 of them
+    inline bool parse_hex(std::string_view in, std::size_t start, std::uint64_t& returning) noexcept {
+      const std::size_t digits = in.size() - start;
+      if (digits == 0 || digits > 16) {
+        return false;
+      }
+      std::uint64_t value = 0;
+      if (in.size() < 8) {
+        for (char c : in.substr(start)) {
+          unsigned digit = static_cast<unsigned char>(c) - static_cast<unsigned>('0');
+          if (digit > 9) {
+            digit = (static_cast<unsigned char>(c) | 0x20u) - static_cast<unsigned>('a');
+            if (digit > 5) {
+              return false;
+            }
+            digit += 10;
+          }
+          value = (value << 4) | digit;
+        }
+      } else {
+        char const* end = in.data() + in.size();
+        if (digits > 8) {
+          const std::uint64_t high = swar::load(in.data() + start);
+          if (!swar::is_8_hex_digits(high)) {
+            return false;
+          }
+          value = static_cast<std::uint64_t>(swar::parse_8_hex_digits(high)) << (4 * (digits - 8));
+        }
+        const std::uint64_t low = swar::load_last(end, digits > 8 ? 16 - digits : 8 - digits);
+        if (!swar::is_8_hex_digits(low)) {
+          return false;
+        }
+        value |= swar::parse_8_hex_digits(low);
+      }
+      returning = value;
+      return true;
+    }
+
+    //decimal with an optional - for signed types, or hex after a 0x
+    template<typename T>
+    bool parse_integer(std::string_view in, T& returning) noexcept {
+      if constexpr (!swar::ENABLED || !std::is_integral_v<T> || std::is_same_v<T, bool> || sizeof(T) > sizeof(std::uint64_t)) {
+        return false;
+      } else {
+        std::uint64_t magnitude = 0;
+        bool negative = false;
+        if (in.size() > 2 && in[0] == '0' && (in[1] == 'x' || in[1] == 'X')) {
+          if (!parse_hex(in, 2, magnitude)) {
+            return false;
+          }
+        } else {
+          std::size_t start = 0;
+          if constexpr (std::is_signed_v<T>) {
+            if (!in.empty() && in[0] == '-') {
+              negative = true;
+              start = 1;
+            }
+          }
+          if (!parse_decimal(in, start, magnitude)) {
+            return false;
+          }
+        }
+
+        using Unsigned = std::make_unsigned_t<T>;
+        constexpr std::uint64_t MAX = static_cast<Unsigned>(std::numeric_limits<T>::max());
+        if (negative) {
+          if (magnitude > MAX + 1) {
+            return false;
+          }
+          returning = static_cast<T>(static_cast<Unsigned>(0 - magnitude));
+        } else {
+          if (magnitude > MAX) {
+            return false;
+          }
+          returning = static_cast<T>(magnitude);
+        }
+        return true;
+      }
+    }
+
+    //[-]digits[.digits] where the digits fit the mantissa and the power of ten is exact,
+    //so one division is correctly rounded
+    template<typename T>
+    bool parse_fixed_float(std::string_view in, T& returning) noexcept {
+      if constexpr (!std::is_same_v<T, float> && !std::is_same_v<T, double>) {
+        return false;
+      } else {
+        constexpr std::uint64_t MAX_MANTISSA = std::uint64_t(1) << std::numeric_limits<T>::digits;
+        constexpr std::size_t MAX_POWER = std::is_same_v<T, float> ? 10 : 22;
+        constexpr auto POW10 = [] {
+          std::array<T, MAX_POWER + 1> returning{};
+          T power = 1;
+          for (auto& elem : returning) {
+            elem = power;
+            power *= 10;
+          }
+          return returning;
+        }();
+
+        std::size_t on = 0;
+        const bool negative = !in.empty() && in[0] == '-';
+        if (negative) {
+          ++on;
+        }
+
+        std::uint64_t mantissa = 0;
+        std::size_t digits = 0;
+        std::size_t fraction_digits = 0;
+        bool dot = false;
+        for (; on < in.size(); ++on) {
+          const unsigned digit = static_cast<unsigned char>(in[on]) - static_cast<unsigned>('0');
+          if (digit <= 9) {
+            mantissa = mantissa * 10 + digit;
+            ++digits;
+            fraction_digits += dot;
+          } else if (in[on] == '.' && !dot && digits != 0) {
+            dot = true;
+          } else {
+            return false;
+          }
+        }
+        if (digits == 0 || digits > 19
+          || (dot && fraction_digits == 0)
+          || fraction_digits > MAX_POWER
+          || mantissa > MAX_MANTISSA) {
+          return false;
+        }
+
+        const T value = static_cast<T>(mantissa) / POW10[fraction_digits];
+        returning = negative ? -value : value;
+        return true;
+      }
+    }
+  }
+}
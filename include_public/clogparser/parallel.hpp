@@ -0,0 +1,226 @@
+#pragma once
+
+#include <vector>
+#include <variant>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+
+#include <clogparser/parser.hpp>
+#include <clogparser/mapped_log.hpp>
+
+namespace clogparser {
+  enum class Delivery {
+    ordered, //in file order, from the calling thread
+    unordered //as each worker parses them, from the worker threads at the same time
+  };
+
+  struct Parallel_options {
+    std::size_t threads = 0; //0 for one per core
+    std::size_t chunk_size = std::size_t{ 4 } << 20;
+    Delivery delivery = Delivery::ordered;
+    //every chunk starts decoding timestamps from a copy of this
+    Timestamp_decoder timestamps = {};
+  };
+
+  namespace internal {
+    //where the first line starting at or after from begins, or the end of log. a \n inside a
+    //quoted column looks like the end of a line, so only starts followed by a timestamp count
+    std::size_t next_line_start(std::string_view log, std::size_t from) noexcept;
+
+    //the starts of the chunks log is split into, followed by its end
+    std::vector<std::size_t> chunk_starts(std::string_view log, std::size_t chunk_size);
+
+    template<typename Cb, typename T>
+    constexpr bool takes_event = std::is_invocable_v<Cb&, Timestamp, const T, std::size_t>;
+
+    template<typename Cb, typename T>
+    constexpr bool takes_only_lazy = !takes_event<Cb, T> && std::is_invocable_v<Cb&, Timestamp, const Lazy<T>, std::size_t>;
+
+    template<typename Cb, typename Types>
+    struct Ordered_delivery;
+
+    //ordered delivery decodes each chunk into a buffer on a worker, then replays the
+    //buffers in order on the calling thread
+    template<typename Cb, typename... Ts>
+    struct Ordered_delivery<Cb, std::variant<Ts...>> {
+      static constexpr bool POSSIBLE = (!takes_only_lazy<Cb, Ts> && ...);
+
+      struct Record {
+        Timestamp time;
+        std::size_t offset;
+        std::variant<Parse_failure, Ts...> event;
+      };
+
+      struct Chunk {
+        std::vector<Record> records;
+        Bump_arena arrays; //the events' arrays, which the worker's parser reuses
+      };
+
+      struct Buffer {
+        template<typename T> requires takes_event<Cb, T>
+        void operator()(Timestamp time, T const& event, std::size_t offset) {
+          chunk->records.push_back(Record{ time, offset, std::variant<Parse_failure, Ts...>{ std::in_place_type<T>, keep_arrays(chunk->arrays, event) } });
+        }
+        void operator()(Parse_failure const& failure) requires std::is_invocable_v<Cb&, Parse_failure const&> {
+          chunk->records.push_back(Record{ Timestamp{}, failure.offset, failure });
+        }
+
+        Chunk* chunk;
+      };
+
+      static void replay(Chunk const& chunk, Cb& cb) {
+        for (Record const& record : chunk.records) {
+          std::visit([&](auto const& event) {
+            using T = std::decay_t<decltype(event)>;
+            if constexpr (std::is_same_v<T, Parse_failure>) {
+              if constexpr (std::is_invocable_v<Cb&, Parse_failure const&>) {
+                cb(event);
+              }
+            } else if constexpr (takes_event<Cb, T>) {
+              cb(record.time, event, record.offset);
+            }
+          }, record.event);
+        }
+      }
+    };
+  }
+
+  //splits log into chunks that start on line boundaries and parses them on worker threads.
+  //with unordered delivery cb is called from several threads at once, so it has to be safe
+  //for that. ordered delivery buffers decoded events, so its cb can't take only Lazy<T>.
+  //the first exception thrown by cb or a worker stops the parse, and is thrown again once
+  //the workers have finished the chunks they're on
+  template<typename Filter = All_events, typename Cb>
+  void parse_parallel(Mapped_log const& log, Cb&& cb, Parallel_options const& options = {}) {
+    using Callback = std::remove_reference_t<Cb>;
+    using Ordered = internal::Ordered_delivery<Callback, typename Filter::Types>;
+    using Chunk = typename Ordered::Chunk;
+
+    if constexpr (!Ordered::POSSIBLE) {
+      if (options.delivery == Delivery::ordered) {
+        throw std::invalid_argument("Ordered delivery needs a callback taking decoded events, not only Lazy<T>");
+      }
+    }
+
+    const std::string_view data = log.data();
+    const std::vector<std::size_t> starts = internal::chunk_starts(data, std::max<std::size_t>(options.chunk_size, 1));
+    const std::size_t chunks = starts.size() - 1;
+
+    std::size_t threads = options.threads;
+    if (threads == 0) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, chunks);
+    if (threads == 0) {
+      return;
+    }
+
+    auto chunk = [&](std::size_t i) {
+      return data.substr(starts[i], starts[i + 1] - starts[i]);
+    };
+
+    Callback& target = cb;
+    std::atomic<std::size_t> next_chunk{ 0 };
+
+    if (options.delivery == Delivery::unordered) {
+      std::exception_ptr failed;
+      std::mutex failed_mutex;
+      auto work = [&] {
+        try {
+          for (std::size_t i; (i = next_chunk.fetch_add(1)) < chunks;) {
+            Parser<Callback&, Filter> parser{ target, options.timestamps };
+            parser.parse_all(chunk(i), starts[i]);
+          }
+        } catch (...) { //the other workers stop after the chunk they're on
+          next_chunk = chunks;
+          std::lock_guard lock{ failed_mutex };
+          if (!failed) {
+            failed = std::current_exception();
+          }
+        }
+      };
+      {
+        std::vector<std::jthread> workers;
+        for (std::size_t i = 0; i < threads; ++i) {
+          workers.emplace_back(work);
+        }
+      }
+      if (failed) {
+        std::rethrow_exception(failed);
+      }
+    } else if constexpr (Ordered::POSSIBLE) {
+      //a worker only starts a chunk this far ahead of the one being delivered, bounding
+      //how much is buffered
+      const std::size_t window = 2 * threads;
+      std::vector<Chunk> buffers(chunks);
+      std::vector<char> done(chunks, false);
+      std::size_t delivering = 0;
+      std::exception_ptr failed; //by a worker
+      std::mutex mutex;
+      std::condition_variable changed;
+
+      auto work = [&] {
+        try {
+          for (std::size_t i; (i = next_chunk.fetch_add(1)) < chunks;) {
+            {
+              std::unique_lock lock{ mutex };
+              changed.wait(lock, [&] { return i < delivering + window; });
+            }
+            Parser<typename Ordered::Buffer, Filter> parser{ typename Ordered::Buffer{ &buffers[i] }, options.timestamps };
+            parser.parse_all(chunk(i), starts[i]);
+            {
+              std::lock_guard lock{ mutex };
+              done[i] = true;
+            }
+            changed.notify_all();
+          }
+        } catch (...) { //delivery stops at the chunk it's waiting for
+          next_chunk = chunks;
+          {
+            std::lock_guard lock{ mutex };
+            if (!failed) {
+              failed = std::current_exception();
+            }
+          }
+          changed.notify_all();
+        }
+      };
+      std::vector<std::jthread> workers;
+      for (std::size_t i = 0; i < threads; ++i) {
+        workers.emplace_back(work);
+      }
+
+      try {
+        for (std::size_t i = 0; i < chunks; ++i) {
+          {
+            std::unique_lock lock{ mutex };
+            changed.wait(lock, [&] { return done[i] != 0 || failed; });
+            if (done[i] == 0) {
+              std::rethrow_exception(failed);
+            }
+          }
+          Ordered::replay(buffers[i], target);
+          buffers[i] = Chunk{};
+          {
+            std::lock_guard lock{ mutex };
+            delivering = i + 1;
+          }
+          changed.notify_all();
+        }
+      } catch (...) { //let the workers run out of chunks so they can be joined
+        next_chunk = chunks;
+        {
+          std::lock_guard lock{ mutex };
+          delivering = chunks;
+        }
+        changed.notify_all();
+        throw;
+      }
+    }
+  }
+}
@@ -9,9 +9,18 @@
 #include <optional>
 #include <charconv>
 #include <unordered_map>
+#include <array>
+#include <bit>
+#include <algorithm>
+#include <mutex>
 
 #include <clogparser/types.hpp>
+#include <clogparser/bump_arena.hpp>
 #include <clogparser/item.hpp>
+#include <clogparser/scanner.hpp>
+#include <clogparser/numbers.hpp>
+#include <clogparser/interner.hpp>
+#include <clogparser/guid.hpp>
 
 namespace clogparser {
   using Period = std::chrono::milliseconds;
@@ -23,20 +32,79 @@ namespace clogparser {
     std::uint8_t minute;
     std::uint8_t second;
     std::uint16_t millisecond;
+    std::uint16_t year; //0 when it isn't known
 
-    //assumes both timestamps are +- 24 hours
+    //exact when both years are known, otherwise assumes both timestamps are +- 24 hours
     Period operator-(Timestamp const& other) const noexcept;
+
+    //time since the unix epoch, only meaningful when the year is known
+    Period since_epoch() const noexcept;
+    //the timestamp since_epoch came from
+    static Timestamp from_epoch(Period since_epoch) noexcept;
   };
 
   constexpr bool is_invalid_guid(std::string_view in) {
     return in.empty() || in[0] == '0';
   }
+  constexpr bool is_invalid_guid(Guid in) noexcept {
+    return in.type() == Guid::Type::none;
+  }
+
+  //why a line couldn't be parsed. malformed input is reported through these instead of exceptions
+  enum class Parse_error : std::uint8_t {
+    none,
+    missing_timestamp,
+    missing_type,
+    bad_timestamp,
+    bad_number,
+    not_enough_columns,
+    unterminated_quote,
+    unterminated_array,
+    unterminated_tuple,
+    unexpected_value
+  };
+
+  std::string_view to_string(Parse_error error) noexcept;
+
+  //handed to a callback taking one when a line is dropped
+  struct Parse_failure {
+    Parse_error reason;
+    std::size_t offset; //of the start of the line
+    std::string_view line;
+  };
+
+  //the date in a WoWCombatLog-MMDDYY_HHMMSS.txt file name
+  std::optional<std::chrono::year_month_day> log_file_date(std::string_view file_name) noexcept;
+
+  //decodes the timestamps that start each line. consecutive lines nearly always share
+  //everything down to the second, so that part of the last one is kept and a line
+  //repeating it only has its fraction of a second decoded
+  struct Timestamp_decoder {
+  public:
+    Timestamp_decoder() noexcept = default;
+    //lines without a year get theirs from log_start, moving on a year each time
+    //the month goes backwards
+    explicit Timestamp_decoder(std::chrono::year_month_day log_start) noexcept;
+    //for lines from time on, without years if time's isn't known
+    static Timestamp_decoder starting_at(Timestamp time) noexcept;
+
+    //M/D[/YYYY] HH:MM:SS.fraction, with anything after the fraction's digits ignored
+    std::optional<Timestamp> decode(std::string_view in, Parse_error& error) noexcept;
+  private:
+    bool decode_prefix_(std::string_view prefix) noexcept;
+
+    std::array<char, 24> prefix_{};
+    std::size_t prefix_size_ = 0; //0 when nothing is cached
+    Timestamp last_{};
+    std::uint16_t year_ = 0;
+    std::uint8_t month_ = 0;
+  };
 
   namespace events {
     //shared
     struct Unit {
       static constexpr std::size_t COLUMNS_COUNT = 4;
-      std::string_view guid;
+      Guid guid;
       std::string_view name;
       Unit_flags flags;
       Raid_flags raid_flags;
@@ -57,8 +125,8 @@ namespace clogparser {
 
     struct Advanced_info {
       static constexpr std::size_t COLUMNS_COUNT = 17;
-      std::string_view advanced_unit_guid;
-      std::string_view owner_guid;
+      Guid advanced_unit_guid;
+      Guid owner_guid;
       std::uint64_t current_hp;
       std::uint64_t max_hp;
       std::int64_t attack_power;
@@ -386,10 +454,12 @@ namespace clogparser {
       std::uint64_t instance_id;
     };
 
+    //the arrays are in the parser's arena, so like the views of a line split across parse()
+    //calls they're only valid during the callback. a String_store copies them
     struct Combatant_info {
       static constexpr std::string_view NAME = "COMBATANT_INFO";
       static constexpr std::size_t COLUMNS_COUNT = 2 + Stats::size + 9;
-      std::string_view guid;
+      Guid guid;
       FactionId faction;
       Stats stats;
       SpecId current_spec_id;
@@ -397,14 +467,14 @@ namespace clogparser {
         std::uint32_t trait_node_entry_id;
         std::uint8_t rank;
       };
-      std::vector<Talent> talents;
-      std::vector<std::string_view> pvp_talents;
-      std::vector<Item> items;
+      std::span<const Talent> talents;
+      std::span<const std::string_view> pvp_talents;
+      std::span<const Item> items;
       struct Interesting_aura {
-        std::string_view caster_guid;
+        Guid caster_guid;
         std::uint64_t spell_id;
       };
-      std::vector<Interesting_aura> interesting_auras;
+      std::span<const Interesting_aura> interesting_auras;
       //pvp
       std::uint32_t honor_level;
       std::uint32_t season;
@@ -460,11 +530,22 @@ namespace clogparser {
   }
 
   namespace helpers {
+    //error is only written on failure, so one error can collect a whole line's worth of parses
     template<typename T>
-    void parseInt(T& returning, std::string_view in) {
+    void parseInt(T& returning, std::string_view in, Parse_error& error) noexcept {
+      if constexpr (std::is_integral_v<T>) {
+        if (parse_integer(in, returning)) {
+          return;
+        }
+      } else {
+        if (parse_fixed_float(in, returning)) {
+          return;
+        }
+      }
+
       std::from_chars_result res;
       if constexpr (std::is_integral_v<T>) {
-        if (in.size() > 3 && (in.starts_with("0x") || in.starts_with("0X"))) {
+        if (in.size() > 2 && (in.starts_with("0x") || in.starts_with("0X"))) {
           res = std::from_chars(in.data() + 2, in.data() + in.size(), returning, 16);
         } else {
           res = std::from_chars(in.data(), in.data() + in.size(), returning);
@@ -473,19 +554,34 @@ namespace clogparser {
         res = std::from_chars(in.data(), in.data() + in.size(), returning);
       }
       if (res.ec != std::errc()) {
-        throw std::exception("Couldn't parse string to int");
+        error = Parse_error::bad_number;
       }
     }
 
-    void parseInt(bool& returning, std::string_view in);
+    void parseInt(bool& returning, std::string_view in, Parse_error& error) noexcept;
 
     template<typename T>
-    T parseInt(std::string_view in) {
+    T parseInt(std::string_view in, Parse_error& error) noexcept {
       T returning = 0;
-      parseInt(returning, in);
+      parseInt(returning, in, error);
       return returning;
     }
 
+    //the power columns hold a value for each power a unit has, separated by |. only the
+    //first is decoded
+    constexpr std::string_view first_power(std::string_view in) noexcept {
+      return in.substr(0, in.find('|'));
+    }
+
+    //a guid of a shape Guid doesn't know is kept as an unknown one rather than failing
+    //the line, so a new kind of guid in a patch doesn't drop events
+    inline Guid parse_guid(std::string_view in, Parse_error&) noexcept {
+      if (const std::optional<Guid> parsed = Guid::parse(in)) {
+        return *parsed;
+      }
+      return Guid::opaque(in);
+    }
+
     using Columns_span = std::span<std::string_view>;
 
     struct Parsed {
@@ -498,6 +594,10 @@ namespace clogparser {
     public:
       template<char delim, char... quotes>
       Parsed parse_for(std::string_view in) {
+        if constexpr (sizeof...(quotes) == 1) {
+          return parse_for_masked_<delim, quotes...>(in);
+        }
+
         std::string_view::size_type start = 0;
 
         std::string_view::size_type found_char;
@@ -535,85 +635,827 @@ namespace clogparser {
         }
       }
     private:
+      //with a single quote char the block scanner can track quote state for us
+      template<char delim, char quote>
+      Parsed parse_for_masked_(std::string_view in) {
+        bool in_quote = looking_for_quote_.has_value();
+        const auto found_char = find_unquoted(in, 0, delim, quote, in_quote);
+
+        if (in_quote) {
+          looking_for_quote_ = quote;
+        } else {
+          looking_for_quote_.reset();
+        }
+
+        Parsed returning;
+        if (found_char != std::string_view::npos) {
+          returning.found_str = in.substr(0, found_char);
+          returning.rest = in.substr(found_char + 1);
+          returning.found = true;
+        }
+        return returning;
+      }
+
       std::optional<char> looking_for_quote_;
     };
 
-    Columns_span parse_array(Columns_span returning, std::string_view in);
-    void parse_array(std::vector<std::string_view>& returning, std::string_view in);
-    std::vector<std::string_view> parse_array(std::string_view in);
+    Columns_span parse_array(Columns_span returning, std::string_view in, Parse_error& error) noexcept;
+    void parse_array(std::vector<std::string_view>& returning, std::string_view in, Parse_error& error);
+    std::vector<std::string_view> parse_array(std::string_view in, Parse_error& error);
   }
 
   namespace internal {
-    struct String_hash {
-      using is_transparent = void;
+    //decodes in on its own, without the year or the cache of a Timestamp_decoder
+    std::optional<Timestamp> parse_timestamp(std::string_view in, Parse_error& error) noexcept;
 
-      std::size_t operator()(std::string const& str) const noexcept;
-      std::size_t operator()(std::string_view str) const noexcept;
+    struct Partial_parse {
+      std::string_view time;
+      std::string_view type;
+      std::string_view data;
     };
 
-    struct String_eq {
-      using is_transparent = void;
+    std::optional<Partial_parse> parse_line(helpers::Parser& parser, std::string_view in, Parse_error& error) noexcept;
 
-      template<typename T, typename U>
-      bool operator()(T const& t, U const& u) const noexcept {
-        return t == u;
-      }
+    //sets error and returns a partly filled T when columns are malformed
+    template<typename T>
+    struct Parse {
+      static T parse(helpers::Columns_span, Parse_error& error) noexcept;
     };
 
-    std::optional<Timestamp> parse_timestamp(std::string_view in);
+    template<> events::Unit Parse<events::Unit>::parse(helpers::Columns_span, Parse_error& error) noexcept;
+    template<> events::Combat_header Parse<events::Combat_header>::parse(helpers::Columns_span, Parse_error& error) noexcept;
+    template<> events::Spell_info Parse<events::Spell_info>::parse(helpers::Columns_span, Parse_error& error) noexcept;
+    template<> events::Advanced_info Parse<events::Advanced_info>::parse(helpers::Columns_span, Parse_error& error) noexcept;
+    template<> events::Damage Parse<events::Damage>::parse(helpers::Columns_span, Parse_error& error) noexcept;
+    template<> events::Heal Parse<events::Heal>::parse(helpers::Columns_span, Parse_error& error) noexcept;
 
-    struct Partial_parse {
-      std::string_view time;
-      std::string_view type;
-      std::string_view data;
+    //the arrays go in arena, which isn't reset first
+    template<>
+    struct Parse<events::Combatant_info> {
+      static events::Combatant_info parse(helpers::Columns_span, Bump_arena& arena, Parse_error& error);
     };
 
-    std::optional<Partial_parse> parse_line(helpers::Parser& parser, std::string_view in);
+    //the parts of a COMBATANT_INFO, the arrays from the text of their column
+    Stats parse_stats(helpers::Columns_span, Parse_error& error) noexcept;
+    std::span<const events::Combatant_info::Talent> parse_talents(Bump_arena& arena, std::string_view in, Parse_error& error);
+    std::span<const std::string_view> parse_pvp_talents(Bump_arena& arena, std::string_view in, Parse_error& error);
+    std::span<const Item> parse_items(Bump_arena& arena, std::string_view in, Parse_error& error);
+    std::span<const events::Combatant_info::Interesting_aura> parse_interesting_auras(Bump_arena& arena, std::string_view in, Parse_error& error);
 
+    //T has arrays, which are decoded into the parser's arena
     template<typename T>
-    struct Parse {
-      static T parse(helpers::Columns_span);
+    constexpr bool uses_arena = requires(helpers::Columns_span columns, Bump_arena& arena, Parse_error& error) {
+      Parse<T>::parse(columns, arena, error);
     };
 
     template<typename T>
-    struct Switch_partial_parse;
+    T decode(helpers::Columns_span columns, Bump_arena& arena, Parse_error& error) noexcept(!uses_arena<T>) {
+      if constexpr (uses_arena<T>) {
+        return Parse<T>::parse(columns, arena, error);
+      } else {
+        return Parse<T>::parse(columns, error);
+      }
+    }
 
-    template<typename First, typename ...Rest>
-    struct Switch_partial_parse<std::variant<First, Rest...>> {
-      template<typename Cb>
-      static void check(Partial_parse const& partial_parse, std::size_t start_of_line, Cb&& cb) noexcept {
-        if (partial_parse.type == First::NAME) {
-          if constexpr (std::is_invocable_v<Cb, Timestamp, const First, std::size_t>) {
-            const auto timestamp = parse_timestamp(partial_parse.time);
-            if (!timestamp) { //we couldn't parse timestamp, just ignore this entry?
-              return;
-            }
-            std::array<std::string_view, First::COLUMNS_COUNT> columns;
-            const auto parsed_columns = helpers::parse_array(columns, partial_parse.data);
-            const First data = Parse<First>::parse(parsed_columns);
-            cb(*timestamp, data, start_of_line);
-          } else {
-            //do nothing
+    //event with its arrays copied into arena, so it outlives the parser that decoded it
+    template<typename T>
+    T keep_arrays(Bump_arena&, T const& event) {
+      return event;
+    }
+    events::Combatant_info keep_arrays(Bump_arena& arena, events::Combatant_info const& event);
+
+    //the column each shared part of an event starts at, for Lazy
+    template<typename T>
+    struct Layout {};
+
+    struct Header_layout {
+      static constexpr std::size_t combat_header = 0;
+    };
+    struct Spell_layout : Header_layout {
+      static constexpr std::size_t spell = events::Combat_header::COLUMNS_COUNT;
+    };
+    struct Spell_advanced_layout : Spell_layout {
+      static constexpr std::size_t advanced = spell + events::Spell_info::COLUMNS_COUNT;
+    };
+    struct Spell_damage_layout : Spell_advanced_layout {
+      static constexpr std::size_t damage = advanced + events::Advanced_info::COLUMNS_COUNT;
+    };
+    struct Spell_heal_layout : Spell_advanced_layout {
+      static constexpr std::size_t heal = advanced + events::Advanced_info::COLUMNS_COUNT;
+    };
+    struct Swing_damage_layout : Header_layout {
+      static constexpr std::size_t advanced = events::Combat_header::COLUMNS_COUNT;
+      static constexpr std::size_t damage = advanced + events::Advanced_info::COLUMNS_COUNT;
+    };
+
+    template<> struct Layout<events::Spell_aura_applied> : Spell_layout {};
+    template<> struct Layout<events::Spell_aura_applied_dose> : Spell_layout {};
+    template<> struct Layout<events::Spell_aura_refresh> : Spell_layout {};
+    template<> struct Layout<events::Spell_aura_removed> : Spell_layout {};
+    template<> struct Layout<events::Spell_aura_removed_dose> : Spell_layout {};
+    template<> struct Layout<events::Spell_periodic_damage> : Spell_damage_layout {};
+    template<> struct Layout<events::Spell_periodic_damage_support> : Spell_damage_layout {};
+    template<> struct Layout<events::Spell_periodic_missed> : Spell_layout {};
+    template<> struct Layout<events::Spell_periodic_heal> : Spell_heal_layout {};
+    template<> struct Layout<events::Spell_absorbed> : Header_layout {};
+    template<> struct Layout<events::Spell_heal_absorbed> : Spell_layout {};
+    template<> struct Layout<events::Swing_missed> : Header_layout {};
+    template<> struct Layout<events::Swing_damage> : Swing_damage_layout {};
+    template<> struct Layout<events::Swing_damage_landed> : Swing_damage_layout {};
+    template<> struct Layout<events::Swing_damage_landed_support> : Spell_damage_layout {};
+    template<> struct Layout<events::Spell_missed> : Spell_layout {};
+    template<> struct Layout<events::Spell_damage> : Spell_damage_layout {};
+    template<> struct Layout<events::Spell_damage_support> : Spell_damage_layout {};
+    template<> struct Layout<events::Spell_heal> : Spell_heal_layout {};
+    template<> struct Layout<events::Spell_cast_success> : Spell_advanced_layout {};
+    template<> struct Layout<events::Unit_died> : Header_layout {};
+    template<> struct Layout<events::Spell_resurrect> : Spell_layout {};
+  }
+
+  //a split but undecoded part of an event, each accessor decodes only the column it reads.
+  //views the columns of the line being parsed, so it's only valid during the callback.
+  //accessors that fail to decode record it in error(), and the line is reported as
+  //failed once the callback returns. arena is where decode() puts T's arrays, if it has any
+  template<typename T>
+  struct Lazy {
+  public:
+    Lazy(helpers::Columns_span columns, Parse_error& error, Bump_arena* arena = nullptr) noexcept :
+      columns_(columns),
+      error_(&error),
+      arena_(arena) {
+
+    }
+
+    helpers::Columns_span columns() const noexcept {
+      return columns_;
+    }
+
+    Parse_error error() const noexcept {
+      return *error_;
+    }
+
+    //decodes every column
+    T decode() const noexcept(!internal::uses_arena<T>) {
+      if constexpr (internal::uses_arena<T>) {
+        return internal::Parse<T>::parse(columns_, *arena_, *error_);
+      } else {
+        return internal::Parse<T>::parse(columns_, *error_);
+      }
+    }
+
+    auto combat_header() const noexcept requires requires { internal::Layout<T>::combat_header; } {
+      return part_<events::Combat_header>(internal::Layout<T>::combat_header);
+    }
+    auto spell() const noexcept requires requires { internal::Layout<T>::spell; } {
+      return part_<events::Spell_info>(internal::Layout<T>::spell);
+    }
+    auto advanced() const noexcept requires requires { internal::Layout<T>::advanced; } {
+      return part_<events::Advanced_info>(internal::Layout<T>::advanced);
+    }
+    auto damage() const noexcept requires requires { internal::Layout<T>::damage; } {
+      return part_<events::Damage>(internal::Layout<T>::damage);
+    }
+    auto heal() const noexcept requires requires { internal::Layout<T>::heal; } {
+      return part_<events::Heal>(internal::Layout<T>::heal);
+    }
+
+    //how many columns a line needs for every part above to be there
+    static constexpr std::size_t min_columns() noexcept {
+      std::size_t returning = 0;
+      if constexpr (requires { internal::Layout<T>::combat_header; }) {
+        returning = std::max(returning, internal::Layout<T>::combat_header + events::Combat_header::COLUMNS_COUNT);
+      }
+      if constexpr (requires { internal::Layout<T>::spell; }) {
+        returning = std::max(returning, internal::Layout<T>::spell + events::Spell_info::COLUMNS_COUNT);
+      }
+      if constexpr (requires { internal::Layout<T>::advanced; }) {
+        returning = std::max(returning, internal::Layout<T>::advanced + events::Advanced_info::COLUMNS_COUNT);
+      }
+      if constexpr (requires { internal::Layout<T>::damage; }) {
+        returning = std::max(returning, internal::Layout<T>::damage + events::Damage::COLUMNS_COUNT);
+      }
+      if constexpr (requires { internal::Layout<T>::heal; }) {
+        returning = std::max(returning, internal::Layout<T>::heal + events::Heal::COLUMNS_COUNT);
+      }
+      return returning;
+    }
+  private:
+    template<typename Part>
+    Lazy<Part> part_(std::size_t start) const noexcept {
+      return Lazy<Part>{ columns_.subspan(start, Part::COLUMNS_COUNT), *error_ };
+    }
+
+    helpers::Columns_span columns_;
+    Parse_error* error_;
+    Bump_arena* arena_;
+  };
+
+  template<>
+  struct Lazy<events::Unit> {
+  public:
+    Lazy(helpers::Columns_span columns, Parse_error& error) noexcept :
+      columns_(columns),
+      error_(&error) {
+
+    }
+
+    Guid guid() const noexcept {
+      return helpers::parse_guid(columns_[0], *error_);
+    }
+    std::string_view name() const noexcept {
+      return columns_[1];
+    }
+    Unit_flags flags() const noexcept {
+      return Unit_flags(helpers::parseInt<Unit_flags::Underlying>(columns_[2], *error_));
+    }
+    Raid_flags raid_flags() const noexcept {
+      return Raid_flags(helpers::parseInt<Raid_flags::Underlying_type>(columns_[3], *error_));
+    }
+
+    events::Unit decode() const noexcept {
+      return internal::Parse<events::Unit>::parse(columns_, *error_);
+    }
+  private:
+    helpers::Columns_span columns_;
+    Parse_error* error_;
+  };
+
+  template<>
+  struct Lazy<events::Combat_header> {
+  public:
+    Lazy(helpers::Columns_span columns, Parse_error& error) noexcept :
+      columns_(columns),
+      error_(&error) {
+
+    }
+
+    Lazy<events::Unit> source() const noexcept {
+      return Lazy<events::Unit>{ columns_.subspan(0, events::Unit::COLUMNS_COUNT), *error_ };
+    }
+    Lazy<events::Unit> dest() const noexcept {
+      return Lazy<events::Unit>{ columns_.subspan(events::Unit::COLUMNS_COUNT, events::Unit::COLUMNS_COUNT), *error_ };
+    }
+
+    events::Combat_header decode() const noexcept {
+      return internal::Parse<events::Combat_header>::parse(columns_, *error_);
+    }
+  private:
+    helpers::Columns_span columns_;
+    Parse_error* error_;
+  };
+
+  template<>
+  struct Lazy<events::Spell_info> {
+  public:
+    Lazy(helpers::Columns_span columns, Parse_error& error) noexcept :
+      columns_(columns),
+      error_(&error) {
+
+    }
+
+    std::uint64_t id() const noexcept {
+      return helpers::parseInt<std::uint64_t>(columns_[0], *error_);
+    }
+    std::string_view name() const noexcept {
+      return columns_[1];
+    }
+    Spell_schools school() const noexcept {
+      return Spell_schools(helpers::parseInt<Spell_schools::Underlying_type>(columns_[2], *error_));
+    }
+
+    events::Spell_info decode() const noexcept {
+      return internal::Parse<events::Spell_info>::parse(columns_, *error_);
+    }
+  private:
+    helpers::Columns_span columns_;
+    Parse_error* error_;
+  };
+
+  template<>
+  struct Lazy<events::Advanced_info> {
+  public:
+    Lazy(helpers::Columns_span columns, Parse_error& error) noexcept :
+      columns_(columns),
+      error_(&error) {
+
+    }
+
+    Guid advanced_unit_guid() const noexcept {
+      return helpers::parse_guid(columns_[0], *error_);
+    }
+    Guid owner_guid() const noexcept {
+      return helpers::parse_guid(columns_[1], *error_);
+    }
+    std::uint64_t current_hp() const noexcept {
+      return helpers::parseInt<std::uint64_t>(columns_[2], *error_);
+    }
+    std::uint64_t max_hp() const noexcept {
+      return helpers::parseInt<std::uint64_t>(columns_[3], *error_);
+    }
+    std::int64_t attack_power() const noexcept {
+      return helpers::parseInt<std::int64_t>(columns_[4], *error_);
+    }
+    std::int64_t spell_power() const noexcept {
+      return helpers::parseInt<std::int64_t>(columns_[5], *error_);
+    }
+    std::int64_t armor() const noexcept {
+      return helpers::parseInt<std::int64_t>(columns_[6], *error_);
+    }
+    std::int64_t absorb() const noexcept {
+      return helpers::parseInt<std::int64_t>(columns_[7], *error_);
+    }
+    Power_types power_type() const noexcept {
+      return static_cast<Power_types>(helpers::parseInt<int>(helpers::first_power(columns_[8]), *error_));
+    }
+    std::uint64_t current_power() const noexcept {
+      return helpers::parseInt<std::uint64_t>(helpers::first_power(columns_[9]), *error_);
+    }
+    std::uint64_t max_power() const noexcept {
+      return helpers::parseInt<std::uint64_t>(helpers::first_power(columns_[10]), *error_);
+    }
+    std::uint64_t power_cost() const noexcept {
+      return helpers::parseInt<std::uint64_t>(helpers::first_power(columns_[11]), *error_);
+    }
+    float position_x() const noexcept {
+      return helpers::parseInt<float>(columns_[12], *error_);
+    }
+    float position_y() const noexcept {
+      return helpers::parseInt<float>(columns_[13], *error_);
+    }
+    std::uint64_t map_id() const noexcept {
+      return helpers::parseInt<std::uint64_t>(columns_[14], *error_);
+    }
+    float facing() const noexcept {
+      return helpers::parseInt<float>(columns_[15], *error_);
+    }
+    std::uint16_t level() const noexcept {
+      return helpers::parseInt<std::uint16_t>(columns_[16], *error_);
+    }
+
+    events::Advanced_info decode() const noexcept {
+      return internal::Parse<events::Advanced_info>::parse(columns_, *error_);
+    }
+  private:
+    helpers::Columns_span columns_;
+    Parse_error* error_;
+  };
+
+  template<>
+  struct Lazy<events::Damage> {
+  public:
+    Lazy(helpers::Columns_span columns, Parse_error& error) noexcept :
+      columns_(columns),
+      error_(&error) {
+
+    }
+
+    std::int64_t final() const noexcept {
+      return helpers::parseInt<std::int64_t>(columns_[0], *error_);
+    }
+    std::int64_t initial() const noexcept {
+      return helpers::parseInt<std::int64_t>(columns_[1], *error_);
+    }
+    std::int64_t overkill() const noexcept {
+      return helpers::parseInt<std::int64_t>(columns_[2], *error_);
+    }
+    Spell_schools school() const noexcept {
+      return Spell_schools(helpers::parseInt<Spell_schools::Underlying_type>(columns_[3], *error_));
+    }
+    std::int64_t resisted() const noexcept {
+      return helpers::parseInt<std::int64_t>(columns_[4], *error_);
+    }
+    std::uint64_t blocked() const noexcept {
+      return helpers::parseInt<std::uint64_t>(columns_[5], *error_);
+    }
+    std::int64_t absorbed() const noexcept {
+      return helpers::parseInt<std::int64_t>(columns_[6], *error_);
+    }
+    bool crit() const noexcept {
+      return helpers::parseInt<bool>(columns_[7], *error_);
+    }
+    bool glancing() const noexcept {
+      return helpers::parseInt<bool>(columns_[8], *error_);
+    }
+    bool crushing() const noexcept {
+      return helpers::parseInt<bool>(columns_[9], *error_);
+    }
+
+    events::Damage decode() const noexcept {
+      return internal::Parse<events::Damage>::parse(columns_, *error_);
+    }
+  private:
+    helpers::Columns_span columns_;
+    Parse_error* error_;
+  };
+
+  template<>
+  struct Lazy<events::Heal> {
+  public:
+    Lazy(helpers::Columns_span columns, Parse_error& error) noexcept :
+      columns_(columns),
+      error_(&error) {
+
+    }
+
+    std::uint64_t final() const noexcept {
+      return helpers::parseInt<std::uint64_t>(columns_[0], *error_);
+    }
+    std::uint64_t initial() const noexcept {
+      return helpers::parseInt<std::uint64_t>(columns_[1], *error_);
+    }
+    std::uint64_t overhealing() const noexcept {
+      return helpers::parseInt<std::uint64_t>(columns_[2], *error_);
+    }
+    std::uint64_t absorbed() const noexcept {
+      return helpers::parseInt<std::uint64_t>(columns_[3], *error_);
+    }
+    bool crit() const noexcept {
+      return helpers::parseInt<bool>(columns_[4], *error_);
+    }
+
+    events::Heal decode() const noexcept {
+      return internal::Parse<events::Heal>::parse(columns_, *error_);
+    }
+  private:
+    helpers::Columns_span columns_;
+    Parse_error* error_;
+  };
+
+  //a Combatant_info with its arrays, most of the line, left as the text of their columns.
+  //they're decoded when asked for, and a String_store keeps one by interning the texts
+  struct Deferred_combatant_info {
+    Guid guid;
+    FactionId faction;
+    Stats stats;
+    SpecId current_spec_id;
+    std::string_view talents_text;
+    std::string_view pvp_talents_text;
+    std::string_view items_text;
+    std::string_view interesting_auras_text;
+    //pvp
+    std::uint32_t honor_level;
+    std::uint32_t season;
+    std::uint32_t rating;
+    std::uint32_t tier;
+
+    std::span<const events::Combatant_info::Talent> talents(Bump_arena& arena, Parse_error& error) const {
+      return internal::parse_talents(arena, talents_text, error);
+    }
+    std::span<const std::string_view> pvp_talents(Bump_arena& arena, Parse_error& error) const {
+      return internal::parse_pvp_talents(arena, pvp_talents_text, error);
+    }
+    std::span<const Item> items(Bump_arena& arena, Parse_error& error) const {
+      return internal::parse_items(arena, items_text, error);
+    }
+    std::span<const events::Combatant_info::Interesting_aura> interesting_auras(Bump_arena& arena, Parse_error& error) const {
+      return internal::parse_interesting_auras(arena, interesting_auras_text, error);
+    }
+
+    events::Combatant_info decode(Bump_arena& arena, Parse_error& error) const {
+      return {
+        guid,
+        faction,
+        stats,
+        current_spec_id,
+        talents(arena, error),
+        pvp_talents(arena, error),
+        items(arena, error),
+        interesting_auras(arena, error),
+        honor_level,
+        season,
+        rating,
+        tier
+      };
+    }
+  };
+
+  //the arrays are decoded into the parser's arena, only if they're asked for
+  template<>
+  struct Lazy<events::Combatant_info> {
+  public:
+    Lazy(helpers::Columns_span columns, Parse_error& error, Bump_arena* arena) noexcept :
+      columns_(columns),
+      error_(&error),
+      arena_(arena) {
+
+    }
+
+    helpers::Columns_span columns() const noexcept {
+      return columns_;
+    }
+
+    Parse_error error() const noexcept {
+      return *error_;
+    }
+
+    Guid guid() const noexcept {
+      return helpers::parse_guid(columns_[0], *error_);
+    }
+    FactionId faction() const noexcept {
+      return FactionId{ helpers::parseInt<std::underlying_type_t<FactionId>>(columns_[1], *error_) };
+    }
+    Stats stats() const noexcept {
+      return internal::parse_stats(columns_.subspan(STATS, Stats::size), *error_);
+    }
+    SpecId current_spec_id() const noexcept {
+      return SpecId{ helpers::parseInt<std::underlying_type_t<SpecId>>(columns_[SPEC], *error_) };
+    }
+    std::span<const events::Combatant_info::Talent> talents() const {
+      return internal::parse_talents(*arena_, columns_[SPEC + 1], *error_);
+    }
+    std::span<const std::string_view> pvp_talents() const {
+      return internal::parse_pvp_talents(*arena_, columns_[SPEC + 2], *error_);
+    }
+    std::span<const Item> items() const {
+      return internal::parse_items(*arena_, columns_[SPEC + 3], *error_);
+    }
+    std::span<const events::Combatant_info::Interesting_aura> interesting_auras() const {
+      return internal::parse_interesting_auras(*arena_, columns_[SPEC + 4], *error_);
+    }
+    std::uint32_t honor_level() const noexcept {
+      return helpers::parseInt<std::uint32_t>(columns_[SPEC + 5], *error_);
+    }
+    std::uint32_t season() const noexcept {
+      return helpers::parseInt<std::uint32_t>(columns_[SPEC + 6], *error_);
+    }
+    std::uint32_t rating() const noexcept {
+      return helpers::parseInt<std::uint32_t>(columns_[SPEC + 7], *error_);
+    }
+    std::uint32_t tier() const noexcept {
+      return helpers::parseInt<std::uint32_t>(columns_[SPEC + 8], *error_);
+    }
+
+    //everything but the arrays, which are kept as text
+    Deferred_combatant_info deferred() const noexcept {
+      return {
+        guid(),
+        faction(),
+        stats(),
+        current_spec_id(),
+        columns_[SPEC + 1],
+        columns_[SPEC + 2],
+        columns_[SPEC + 3],
+        columns_[SPEC + 4],
+        honor_level(),
+        season(),
+        rating(),
+        tier()
+      };
+    }
+
+    events::Combatant_info decode() const {
+      return internal::Parse<events::Combatant_info>::parse(columns_, *arena_, *error_);
+    }
+
+    static constexpr std::size_t min_columns() noexcept {
+      return events::Combatant_info::COLUMNS_COUNT;
+    }
+  private:
+    static constexpr std::size_t STATS = 2;
+    static constexpr std::size_t SPEC = STATS + Stats::size;
+
+    helpers::Columns_span columns_;
+    Parse_error* error_;
+    Bump_arena* arena_;
+  };
+
+  //what a Parser given it as its Stats has seen. a Parser's default No_stats keeps nothing
+  //and costs nothing
+  struct Parse_stats {
+    static constexpr bool ENABLED = true;
+
+    enum class Stage : std::uint8_t {
+      split, //finding the end of each line
+      tokenize, //splitting a line into its timestamp, type and data
+      dispatch, //finding the type's parser
+      decode, //the timestamp and columns of the filter's events
+      callback,
+      COUNT
+    };
+
+    static constexpr std::size_t ERRORS_COUNT = static_cast<std::size_t>(Parse_error::unexpected_value) + 1;
+    static constexpr std::size_t TYPES_COUNT = std::variant_size_v<events::Type>;
+
+    std::uint64_t bytes = 0;
+    std::uint64_t lines = 0;
+    std::array<std::uint64_t, TYPES_COUNT> lines_by_type{}; //by index in events::Type, filtered out or not
+    std::uint64_t unknown_types = 0; //lines of a type that isn't in events::Type
+    std::array<std::uint64_t, ERRORS_COUNT> malformed{}; //dropped lines by Parse_error
+    std::uint64_t straddled = 0; //lines split across two parse calls, put back together in saved_
+    std::uint64_t saved_bytes = 0; //copied into saved_
+    std::array<std::uint64_t, static_cast<std::size_t>(Stage::COUNT)> cycles{}; //by Stage, see internal::cycles
+
+    std::uint64_t& malformed_by(Parse_error error) noexcept {
+      return malformed[static_cast<std::size_t>(error)];
+    }
+    std::uint64_t& cycles_in(Stage stage) noexcept {
+      return cycles[static_cast<std::size_t>(stage)];
+    }
+
+    //the NAME of the type at index in events::Type
+    static std::string_view type_name(std::size_t index) noexcept;
+  };
+
+  struct No_stats {
+    static constexpr bool ENABLED = false;
+  };
+
+  namespace internal {
+    //a count that only ever goes up, the cpu's timestamp counter where there is one and
+    //steady_clock nanoseconds elsewhere
+    std::uint64_t cycles() noexcept;
+
+    //adds the cycles from its construction, or the last next, to its stage of stats
+    template<typename Stats>
+    struct Stage_timer {
+    public:
+      Stage_timer(Stats& stats, Parse_stats::Stage stage) noexcept :
+        stats_(stats),
+        stage_(stage),
+        start_(cycles()) {
+
+      }
+
+      Stage_timer(Stage_timer const&) = delete;
+      Stage_timer& operator=(Stage_timer const&) = delete;
+
+      ~Stage_timer() {
+        stats_.cycles_in(stage_) += cycles() - start_;
+      }
+
+      void next(Parse_stats::Stage stage) noexcept {
+        const std::uint64_t now = cycles();
+        stats_.cycles_in(stage_) += now - start_;
+        stage_ = stage;
+        start_ = now;
+      }
+    private:
+      Stats& stats_;
+      Parse_stats::Stage stage_;
+      std::uint64_t start_;
+    };
+
+    template<>
+    struct Stage_timer<No_stats> {
+      Stage_timer(No_stats&, Parse_stats::Stage) noexcept {}
+      void next(Parse_stats::Stage) noexcept {}
+    };
+  }
+
+  namespace internal {
+    //little endian load of up to 8 bytes of in starting at at
+    constexpr std::uint64_t load_8(std::string_view in, std::size_t at) noexcept {
+      std::uint64_t returning = 0;
+      for (std::size_t i = 0; i < 8 && at + i < in.size(); ++i) {
+        returning |= static_cast<std::uint64_t>(static_cast<unsigned char>(in[at + i])) << (i * 8);
+      }
+      return returning;
+    }
+
+    //distinguishes type names from their first and last 8 bytes and their length
+    constexpr std::uint64_t type_key(std::string_view name) noexcept {
+      const std::size_t last = name.size() > 8 ? name.size() - 8 : 0;
+      return load_8(name, 0) ^ std::rotl(load_8(name, last), 29) ^ name.size();
+    }
+
+    constexpr std::size_t type_slot(std::uint64_t key, std::uint64_t seed, unsigned bits) noexcept {
+      return static_cast<std::size_t>((key * seed) >> (64 - bits));
+    }
+
+    //a perfect hash from the NAMEs of a variant's alternatives to their index, found at compile time
+    template<typename T>
+    struct Type_table;
+
+    template<typename... Ts>
+    struct Type_table<std::variant<Ts...>> {
+      static constexpr std::size_t COUNT = sizeof...(Ts);
+      static constexpr std::array<std::string_view, COUNT> NAMES = { Ts::NAME... };
+      static constexpr unsigned BITS = 7;
+      static constexpr std::uint8_t EMPTY = 0xFF;
+      static_assert(COUNT < EMPTY && COUNT <= (1u << BITS), "Too many types for the type table");
+
+      static constexpr bool collides(std::uint64_t seed) noexcept {
+        std::array<bool, 1 << BITS> used{};
+        for (std::string_view name : NAMES) {
+          const std::size_t slot = type_slot(type_key(name), seed, BITS);
+          if (used[slot]) {
+            return true;
           }
-        } else {
-          Switch_partial_parse<std::variant<Rest...>>::check(partial_parse, start_of_line, std::forward<Cb>(cb));
+          used[slot] = true;
+        }
+        return false;
+      }
+
+      static constexpr std::uint64_t find_seed() noexcept {
+        for (std::uint64_t seed = 0x9E3779B97F4A7C15; ; seed += 2) {
+          if (!collides(seed)) {
+            return seed;
+          }
+        }
+      }
+
+      static constexpr std::uint64_t SEED = find_seed();
+
+      static constexpr std::array<std::uint8_t, 1 << BITS> build_slots() noexcept {
+        std::array<std::uint8_t, 1 << BITS> returning{};
+        returning.fill(EMPTY);
+        for (std::size_t i = 0; i < COUNT; ++i) {
+          returning[type_slot(type_key(NAMES[i]), SEED, BITS)] = static_cast<std::uint8_t>(i);
+        }
+        return returning;
+      }
+
+      static constexpr std::array<std::uint8_t, 1 << BITS> SLOTS = build_slots();
+
+      //index of name in Ts, or COUNT if it isn't one of them. one probe, one compare
+      static constexpr std::size_t find(std::string_view name) noexcept {
+        const std::uint8_t slot = SLOTS[type_slot(type_key(name), SEED, BITS)];
+        if (slot == EMPTY || NAMES[slot] != name) {
+          return COUNT;
         }
+        return slot;
       }
     };
 
-    template<>
-    struct Switch_partial_parse<std::variant<>> {
+    //a callback that takes T gets it decoded, one that only takes Lazy<T> gets that instead
+    //arena is reset for each line of a type that uses it
+    template<typename T, typename Cb, typename Stats>
+    void parse_as(Partial_parse const& partial_parse, std::size_t start_of_line, Cb& cb, Timestamp_decoder& timestamps, Parse_error& error, Stats& stats, Bump_arena& arena) {
+      constexpr bool eager = std::is_invocable_v<Cb&, Timestamp, const T, std::size_t>;
+      constexpr bool lazy = !eager && std::is_invocable_v<Cb&, Timestamp, const Lazy<T>, std::size_t>;
+
+      if constexpr (eager || lazy) {
+        Stage_timer<Stats> timer{ stats, Parse_stats::Stage::decode };
+        const auto timestamp = timestamps.decode(partial_parse.time, error);
+        if (!timestamp) {
+          return;
+        }
+        std::array<std::string_view, T::COLUMNS_COUNT> columns;
+        const auto parsed_columns = helpers::parse_array(columns, partial_parse.data, error);
+        if (error != Parse_error::none) {
+          return;
+        }
+        if constexpr (uses_arena<T>) {
+          arena.reset();
+        }
+        if constexpr (eager) {
+          const T data = decode<T>(parsed_columns, arena, error);
+          if (error != Parse_error::none) {
+            return;
+          }
+          timer.next(Parse_stats::Stage::callback);
+          cb(*timestamp, data, start_of_line);
+        } else {
+          if (parsed_columns.size() < Lazy<T>::min_columns()) {
+            error = Parse_error::not_enough_columns;
+            return;
+          }
+          const Lazy<T> data{ parsed_columns, error, &arena };
+          timer.next(Parse_stats::Stage::callback);
+          cb(*timestamp, data, start_of_line);
+        }
+      } else {
+        //do nothing
+      }
+    }
+
+    template<typename T>
+    struct Switch_partial_parse;
+
+    template<typename... Ts>
+    struct Switch_partial_parse<std::variant<Ts...>> {
       template<typename Cb>
-      static void check(Partial_parse const& partial_parse, std::size_t start_of_line, Cb&&) noexcept {
+      static void check(Partial_parse const& partial_parse, std::size_t start_of_line, Cb&& cb, Timestamp_decoder& timestamps, Parse_error& error) {
+        No_stats stats;
+        Bump_arena arena;
+        check(partial_parse, start_of_line, cb, timestamps, error, stats, arena);
+      }
 
+      template<typename Cb, typename Stats>
+      static void check(Partial_parse const& partial_parse, std::size_t start_of_line, Cb&& cb, Timestamp_decoder& timestamps, Parse_error& error, Stats& stats, Bump_arena& arena) {
+        if constexpr (sizeof...(Ts) > 0) {
+          using Table = Type_table<std::variant<Ts...>>;
+          using Handler = void(*)(Partial_parse const&, std::size_t, std::remove_reference_t<Cb>&, Timestamp_decoder&, Parse_error&, Stats&, Bump_arena&);
+          static constexpr std::array<Handler, sizeof...(Ts)> HANDLERS = { &parse_as<Ts, std::remove_reference_t<Cb>, Stats>... };
+
+          std::size_t index;
+          {
+            Stage_timer<Stats> timer{ stats, Parse_stats::Stage::dispatch };
+            index = Table::find(partial_parse.type);
+          }
+          if (index != Table::COUNT) {
+            HANDLERS[index](partial_parse, start_of_line, cb, timestamps, error, stats, arena);
+          }
+        }
       }
     };
   }
 
-  struct String_store {
+  //the get(event) overloads every string store has, copying the strings an event views
+  //through Store::get(std::string_view)
+  template<typename Store>
+  struct Basic_string_store {
   public:
-    std::string_view get(std::string_view) noexcept;
-
     events::Combat_log_version get(events::Combat_log_version);
     events::Spell_aura_applied get(events::Spell_aura_applied);
     events::Spell_aura_applied_dose get(events::Spell_aura_applied_dose);
@@ -621,19 +1463,26 @@ namespace clogparser {
     events::Spell_aura_removed get(events::Spell_aura_removed);
     events::Spell_aura_removed_dose get(events::Spell_aura_removed_dose);
     events::Spell_periodic_damage get(events::Spell_periodic_damage);
+    events::Spell_periodic_damage_support get(events::Spell_periodic_damage_support);
     events::Spell_periodic_missed get(events::Spell_periodic_missed);
     events::Spell_periodic_heal get(events::Spell_periodic_heal);
     events::Spell_absorbed get(events::Spell_absorbed);
+    events::Spell_heal_absorbed get(events::Spell_heal_absorbed);
     events::Swing_missed get(events::Swing_missed);
+    events::Swing_damage get(events::Swing_damage);
     events::Swing_damage_landed get(events::Swing_damage_landed);
+    events::Swing_damage_landed_support get(events::Swing_damage_landed_support);
     events::Spell_missed get(events::Spell_missed);
     events::Spell_damage get(events::Spell_damage);
+    events::Spell_damage_support get(events::Spell_damage_support);
     events::Spell_heal get(events::Spell_heal);
     events::Spell_cast_success get(events::Spell_cast_success);
     events::Encounter_start get(events::Encounter_start);
     events::Encounter_end get(events::Encounter_end);
     events::Combatant_info::Interesting_aura get(events::Combatant_info::Interesting_aura);
+    Item get(Item);
     events::Combatant_info get(events::Combatant_info);
+    Deferred_combatant_info get(Deferred_combatant_info);
     events::Spell_summon get(events::Spell_summon);
     events::Zone_change get(events::Zone_change);
     events::Map_change get(events::Map_change);
@@ -641,19 +1490,76 @@ namespace clogparser {
     events::Spell_resurrect get(events::Spell_resurrect);
 
     template<typename T>
-    std::vector<T> get(std::vector<T> in) noexcept {
+    std::vector<T> get(std::vector<T> in) {
       for (T& elem : in) {
-        elem = this->get(elem);
+        elem = self_().get(elem);
       }
 
       return in;
     }
 
+    //a copy of in in memory from Store::allocate
+    template<typename T>
+    std::span<const T> get(std::span<const T> in) {
+      const std::span<T> returning = self_().template allocate<T>(in.size());
+      for (std::size_t i = 0; i < in.size(); ++i) {
+        if constexpr (requires { self_().get(in[i]); }) {
+          returning[i] = self_().get(in[i]);
+        } else {
+          returning[i] = in[i];
+        }
+      }
+      return returning;
+    }
+  private:
+    Store& self_() noexcept {
+      return static_cast<Store&>(*this);
+    }
+  };
+
+  struct String_store : public Basic_string_store<String_store> {
+  public:
+    using Basic_string_store<String_store>::get;
+    std::string_view get(std::string_view);
+
+    template<typename T>
+    std::span<T> allocate(std::size_t count) {
+      return arrays_.allocate<T>(count);
+    }
+
+    void clear();
+  private:
+    Interner store_;
+    Bump_arena arrays_;
+  };
+
+  //a String_store parser threads can share, see Concurrent_interner
+  struct Concurrent_string_store : public Basic_string_store<Concurrent_string_store> {
+  public:
+    explicit Concurrent_string_store(std::size_t shards = 16) :
+      store_(shards) {
+
+    }
+
+    using Basic_string_store<Concurrent_string_store>::get;
+    std::string_view get(std::string_view);
+
+    template<typename T>
+    std::span<T> allocate(std::size_t count) {
+      std::lock_guard lock{ arrays_mutex_ };
+      return arrays_.allocate<T>(count);
+    }
+
     void clear();
   private:
-    std::unordered_set<std::string, internal::String_hash, internal::String_eq> store_;
+    Concurrent_interner store_;
+    std::mutex arrays_mutex_;
+    Bump_arena arrays_;
   };
 
+  extern template struct Basic_string_store<String_store>;
+  extern template struct Basic_string_store<Concurrent_string_store>;
+
   struct Event {
     constexpr Event(Timestamp time, events::Type type) noexcept :
       time(std::move(time)),
@@ -665,60 +1571,185 @@ namespace clogparser {
     events::Type type;
   };
 
-  struct Log {
+  //Store can be a reference, letting a Log per thread share one Concurrent_string_store
+  template<typename Store = String_store>
+  struct Basic_log {
+    Basic_log() = default;
+    explicit Basic_log(Store store) :
+      store_(std::forward<Store>(store)) {
+
+    }
+
     auto parsing_cb() noexcept {
-      return [this](Timestamp time, auto const& event, std::size_t bytes_on) {
-        this->events.push_back(Event{ time, store(this->store_, event) });
+      return [this]<typename T>(Timestamp time, T const& event, std::size_t) requires std::is_constructible_v<events::Type, T> {
+        this->events.push_back(Event{ time, this->store_.get(event) });
       };
     }
     std::vector<Event> events;
   private:
-    String_store store_;
+    Store store_;
   };
 
-  template<typename Cb>
+  using Log = Basic_log<>;
+
+  //the event types a Parser decodes. lines of any other type are dropped after looking at
+  //their type column, without parsing their timestamp or splitting their columns
+  template<typename... Events>
+  struct Event_filter {
+    using Types = std::variant<Events...>;
+  };
+
+  namespace internal {
+    template<typename T>
+    struct Filter_of;
+
+    template<typename... Ts>
+    struct Filter_of<std::variant<Ts...>> {
+      using Type = Event_filter<Ts...>;
+    };
+  }
+
+  using All_events = internal::Filter_of<events::Type>::Type;
+
+  //Stats is No_stats, or Parse_stats to count what's parsed and time each stage of it
+  template<typename Cb, typename Filter = All_events, typename Stats = No_stats>
   struct Parser {
   public:
-    Parser(Cb cb) :
-      cb_(std::forward<Cb>(cb)) {
+    Parser(Cb cb, Timestamp_decoder timestamps = {}) :
+      cb_(std::forward<Cb>(cb)),
+      timestamps_(timestamps) {
+
+    }
 
+    Stats const& stats() const noexcept {
+      return stats_;
     }
 
     void parse(std::string_view recved) {
-      helpers::Parsed res;
-      std::optional<internal::Partial_parse> partial_parse;
+      const std::string_view rest = parse_lines_(recved);
+      if constexpr (Stats::ENABLED) {
+        stats_.saved_bytes += rest.size();
+      }
+      saved_.append(rest);
+    }
+
+    //starts over on another log, or offset bytes into one, dropping any partial line
+    //left over from parse
+    void reset(Timestamp_decoder timestamps = {}, std::size_t offset = 0) {
+      saved_.clear();
+      parser_ = {}; //an open quote in the dropped line mustn't carry over
+      bytes_parsed_ = offset;
+      timestamps_ = timestamps;
+    }
+
+    //parses in as a complete log. nothing is copied into saved_, so every view
+    //handed to the callback points into in, including a last line without a \n.
+    //offset is where in starts in the log, for the offsets handed to the callback
+    void parse_all(std::string_view in, std::size_t offset = 0) {
+      assert(saved_.empty());
+      bytes_parsed_ = offset;
+      const std::string_view rest = parse_lines_(in);
+      if (!rest.empty()) {
+        parse_line_(rest, rest.size());
+      }
+    }
 
-      while ((res = parser_.parse_for<'\n', '"'>(recved)).found) {
-        auto found_str_size = 1; //start with 1 for \n
-        if (!res.found_str.empty() && res.found_str.back() == '\r') {
-          res.found_str = res.found_str.substr(0, res.found_str.size() - 1);
-          found_str_size++;
+    //parses lines of in, the rest of a complete log as parse_all takes, until done() is
+    //true after one. returns what's left of in for the next call
+    template<typename Done>
+    std::string_view parse_until(std::string_view in, Done&& done) {
+      assert(saved_.empty());
+      while (!in.empty()) {
+        const helpers::Parsed res = split_(in);
+        if (res.found) {
+          parse_line_(res.found_str, res.found_str.size() + 1); //+1 for \n
+          in = res.rest;
+        } else {
+          parse_line_(in, in.size());
+          in = {};
+        }
+        if (done()) {
+          break;
         }
+      }
+      return in;
+    }
+  private:
+    //returns the trailing bytes of recved that aren't a complete line yet
+    std::string_view parse_lines_(std::string_view recved) {
+      helpers::Parsed res;
+
+      while ((res = split_(recved)).found) {
         if (saved_.empty()) {
-          found_str_size += res.found_str.size();
-          partial_parse = internal::parse_line(parser_, res.found_str);
+          parse_line_(res.found_str, res.found_str.size() + 1); //+1 for \n
         } else {
+          if constexpr (Stats::ENABLED) {
+            ++stats_.straddled;
+            stats_.saved_bytes += res.found_str.size();
+          }
           saved_.append(res.found_str);
-          found_str_size += saved_.size();
-          partial_parse = internal::parse_line(parser_, saved_);
+          parse_line_(saved_, saved_.size() + 1);
+          saved_.clear();
         }
+        recved = res.rest;
+      }
+      return recved;
+    }
+
+    helpers::Parsed split_(std::string_view recved) {
+      internal::Stage_timer<Stats> timer{ stats_, Parse_stats::Stage::split };
+      return parser_.parse_for<'\n', '"'>(recved);
+    }
 
-        if (partial_parse) {
-          internal::Switch_partial_parse<events::Type>::check(*partial_parse, bytes_parsed_, cb_);
-          if (!saved_.empty()) {
-            saved_.clear();
+    void parse_line_(std::string_view line, std::size_t line_size) {
+      if (!line.empty() && line.back() == '\r') {
+        line = line.substr(0, line.size() - 1);
+      }
+
+      Parse_error error = Parse_error::none;
+      std::optional<internal::Partial_parse> partial_parse;
+      {
+        internal::Stage_timer<Stats> timer{ stats_, Parse_stats::Stage::tokenize };
+        partial_parse = internal::parse_line(parser_, line, error);
+      }
+      if (partial_parse) {
+        if constexpr (Stats::ENABLED) {
+          const std::size_t type = internal::Type_table<events::Type>::find(partial_parse->type);
+          if (type == internal::Type_table<events::Type>::COUNT) {
+            ++stats_.unknown_types;
+          } else {
+            ++stats_.lines_by_type[type];
           }
         }
+        internal::Switch_partial_parse<typename Filter::Types>::check(*partial_parse, bytes_parsed_, cb_, timestamps_, error, stats_, arena_);
+      }
+      if (error != Parse_error::none) {
+        if constexpr (Stats::ENABLED) {
+          ++stats_.malformed_by(error);
+        }
+        fail_(error, line);
+      }
 
-        bytes_parsed_ += found_str_size;
-        recved = res.rest;
+      if constexpr (Stats::ENABLED) {
+        ++stats_.lines;
+        stats_.bytes += line_size;
       }
-      saved_.append(recved);
+      bytes_parsed_ += line_size;
     }
-  private:
+
+    //dropped lines go to the callback if it takes a Parse_failure, otherwise they're skipped
+    void fail_(Parse_error error, std::string_view line) {
+      if constexpr (std::is_invocable_v<Cb&, Parse_failure const&>) {
+        cb_(Parse_failure{ error, bytes_parsed_, line });
+      }
+    }
+
     Cb cb_;
+    Timestamp_decoder timestamps_;
     helpers::Parser parser_;
     std::string saved_;
+    Bump_arena arena_; //for the arrays of the event being parsed
     std::size_t bytes_parsed_ = 0;
+    [[no_unique_address]] Stats stats_;
   };
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace clogparser {
+  //objects of any type packed back to back into large blocks, each found again by the
+  //offset push() gave for it. they stay where they are until clear()
+  struct Payload_arena {
+  public:
+    using Offset = std::uint64_t;
+
+    Payload_arena() = default;
+    Payload_arena(Payload_arena&& other) noexcept :
+      blocks_(std::move(other.blocks_)),
+      used_(std::exchange(other.used_, BLOCK_SIZE)),
+      destructors_(std::move(other.destructors_)) {
+
+    }
+    Payload_arena& operator=(Payload_arena other) noexcept {
+      blocks_.swap(other.blocks_);
+      std::swap(used_, other.used_);
+      destructors_.swap(other.destructors_);
+      return *this;
+    }
+    ~Payload_arena();
+
+    template<typename T>
+    Offset push(T value) {
+      static_assert(sizeof(T) <= BLOCK_SIZE && alignof(T) <= alignof(std::max_align_t));
+      const Offset returning = allocate_(sizeof(T), alignof(T));
+      T* const pushed = ::new (at_(returning)) T(std::move(value));
+      if constexpr (!std::is_trivially_destructible_v<T>) {
+        destructors_.push_back(Destructor{ pushed, [](void* object) noexcept { static_cast<T*>(object)->~T(); } });
+      }
+      return returning;
+    }
+
+    template<typename T>
+    T const& get(Offset offset) const noexcept {
+      return *std::launder(reinterpret_cast<T const*>(at_(offset)));
+    }
+
+    //bytes taken by the blocks
+    std::size_t capacity() const noexcept {
+      return blocks_.size() * BLOCK_SIZE;
+    }
+
+    void clear() noexcept;
+  private:
+    struct Destructor {
+      void* object;
+      void(*destroy)(void*) noexcept;
+    };
+
+    static constexpr std::size_t BLOCK_SIZE = std::size_t{ 1 } << 20;
+
+    Offset allocate_(std::size_t size, std::size_t alignment);
+    std::byte* at_(Offset offset) const noexcept {
+      return blocks_[offset / BLOCK_SIZE].get() + offset % BLOCK_SIZE;
+    }
+
+    std::vector<std::unique_ptr<std::byte[]>> blocks_;
+    std::size_t used_ = BLOCK_SIZE; //of the last block
+    std::vector<Destructor> destructors_;
+  };
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <span>
+
+namespace clogparser {
+  namespace helpers {
+    enum class Simd_level {
+      scalar,
+      sse2,
+      avx2
+    };
+
+    //the best instruction set this cpu supports, detected once
+    Simd_level simd_level() noexcept;
+
+    //bit i is set when byte i of a 64 byte block matches
+    struct Line_masks {
+      std::uint64_t delim;
+      std::uint64_t quote;
+    };
+
+    Line_masks line_masks(char const* block, char delim, char quote) noexcept;
+
+    //bit i is set when bit i or any bit below it toggles an odd number of times,
+    //turning a mask of quote chars into a mask of the bytes inside quotes
+    constexpr std::uint64_t prefix_xor(std::uint64_t in) noexcept {
+      in ^= in << 1;
+      in ^= in << 2;
+      in ^= in << 4;
+      in ^= in << 8;
+      in ^= in << 16;
+      in ^= in << 32;
+      return in;
+    }
+
+    struct Column_masks {
+      std::uint64_t comma;
+      std::uint64_t quote;
+      std::uint64_t open; //[ and (
+      std::uint64_t close; //] and )
+    };
+
+    Column_masks column_masks(char const* block) noexcept;
+
+    struct Event_masks {
+      std::uint64_t space;
+      std::uint64_t lead; //any of the leads
+    };
+
+    Event_masks event_masks(char const* block, std::string_view leads) noexcept;
+
+    //finds the first byte at or after start that is one of leads and follows two spaces,
+    //which is where an event's name starts after its timestamp. npos if there isn't one.
+    //the spaces aren't checked to be the ones ending a timestamp
+    std::size_t find_event_start(std::string_view in, std::size_t start, std::string_view leads) noexcept;
+
+    //finds the first delim at or after start that isn't between a pair of quotes.
+    //in_quote is the quote state at start, and is left as the state just after the
+    //returned delim, or at the end of in if there isn't one (npos)
+    std::size_t find_unquoted(std::string_view in, std::size_t start, char delim, char quote, bool& in_quote) noexcept;
+
+    struct Split_columns {
+      //how many columns were written
+      std::size_t count = 0;
+      //where the column after the last one written starts, npos once all of in was split
+      std::size_t rest = std::string_view::npos;
+      //the quote, [ or ( the last column opened and never closed, 0 if it was closed
+      char unterminated = 0;
+    };
+
+    //splits in on the commas that aren't inside quotes or a [] or () column in one pass,
+    //stripping the quotes and brackets around each column. nested arrays and tuples are
+    //left whole inside their column. stops once returning is full
+    Split_columns split_columns(std::string_view in, std::span<std::string_view> returning) noexcept;
+  }
+}
@@ -9,6 +9,10 @@ namespace clogparser {
   public:
     using Underlying = std::uint32_t;
 
+    constexpr Unit_flags() noexcept :
+      val_(0) {
+
+    }
     constexpr Unit_flags(Underlying val) noexcept :
       val_(val) {
 
@@ -67,6 +71,10 @@ namespace clogparser {
   struct Raid_flags {
   public:
     using Underlying_type = std::uint32_t;
+    constexpr Raid_flags() noexcept :
+      val_(0) {
+
+    }
     constexpr Raid_flags(Underlying_type val) :
       val_(val) {
 
@@ -110,6 +118,10 @@ namespace clogparser {
       arcane = 0x40
     };
     
+    constexpr Spell_schools() noexcept :
+      val_(0) {
+
+    }
     constexpr Spell_schools(Underlying_type val) :
       val_(val) {
 
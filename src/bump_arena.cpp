@@ -0,0 +1,35 @@
+#include <clogparser/bump_arena.hpp>
+
+#include <algorithm>
+#include <utility>
+
+void clogparser::Bump_arena::clear() noexcept {
+  blocks_.clear();
+  reset();
+}
+
+std::size_t clogparser::Bump_arena::capacity() const noexcept {
+  std::size_t returning = 0;
+  for (Block const& block : blocks_) {
+    returning += block.size;
+  }
+  return returning;
+}
+
+void* clogparser::Bump_arena::next_block_(std::size_t size) {
+  const std::size_t next = block_ < blocks_.size() ? block_ + 1 : block_;
+  //a block too small for this is only replaced, never skipped, so a reset arena keeps
+  //allocating from the same blocks in the same order
+  if (next == blocks_.size() || blocks_[next].size < size) {
+    const std::size_t block_size = std::max(BLOCK_SIZE, size);
+    Block adding{ std::make_unique_for_overwrite<std::byte[]>(block_size), block_size };
+    if (next == blocks_.size()) {
+      blocks_.push_back(std::move(adding));
+    } else {
+      blocks_[next] = std::move(adding);
+    }
+  }
+  block_ = next;
+  used_ = size;
+  return blocks_[next].data.get();
+}
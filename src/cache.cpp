@@ -0,0 +1,253 @@
+#include <clogparser/cache.hpp>
+#include <clogparser/parallel.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+namespace {
+  constexpr std::array<char, 8> MAGIC = { 'C', 'L', 'O', 'G', 'C', 'A', 'C', 'H' };
+  constexpr std::uint32_t VERSION = 1;
+  constexpr std::uint32_t ENDIAN = 0x01020304;
+
+  struct Section {
+    std::uint64_t offset;
+    std::uint64_t count;
+  };
+
+  struct Header {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t endian;
+    std::uint64_t types; //hash of the NAMEs of events::Type, which Cached_event::type indexes
+    std::uint64_t log_size;
+    std::uint64_t log_start;
+    Section events;
+    Section units;
+    Section encounters;
+    Section strings;
+    Section string_data;
+  };
+
+  std::uint64_t fnv1a(std::string_view in, std::uint64_t hash = 14695981039346656037ull) noexcept {
+    for (const char c : in) {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    return hash;
+  }
+
+  template<typename... Ts>
+  std::uint64_t types_hash(std::variant<Ts...> const*) noexcept {
+    std::uint64_t hash = fnv1a({});
+    ((hash = fnv1a(",", fnv1a(Ts::NAME, hash))), ...);
+    return hash;
+  }
+
+  struct Builder {
+    template<typename T>
+      requires (clogparser::internal::Index_in<T, clogparser::events::Type>::VALUE < std::variant_size_v<clogparser::events::Type>)
+    void operator()(clogparser::Timestamp time, T const& event, std::size_t offset) {
+      clogparser::Cached_event adding{
+        time.since_epoch().count(),
+        0,
+        offset,
+        clogparser::Cached_event::NO_UNIT,
+        clogparser::Cached_event::NO_UNIT,
+        0,
+        static_cast<std::uint8_t>(clogparser::internal::Index_in<T, clogparser::events::Type>::VALUE),
+        {}
+      };
+      if constexpr (clogparser::internal::has_units<T>) {
+        adding.source = units.id(event.combat_header.source.guid);
+        adding.dest = units.id(event.combat_header.dest.guid);
+      }
+      if constexpr (clogparser::internal::has_spell<T>) {
+        adding.spell = static_cast<std::uint32_t>(event.spell.id);
+      }
+      if constexpr (clogparser::internal::has_amount<T>) {
+        adding.amount = clogparser::internal::amount_of(event);
+      }
+      events.push_back(adding);
+
+      if constexpr (std::is_same_v<T, clogparser::events::Encounter_start>) {
+        encounters.push_back(clogparser::Cached_encounter{
+          events.size() - 1,
+          0,
+          adding.time,
+          adding.time,
+          event.encounter_id,
+          strings.intern(event.encounter_name).id,
+          event.difficulty_id,
+          event.instance_size,
+          false,
+          false,
+          0 });
+      } else if constexpr (std::is_same_v<T, clogparser::events::Encounter_end>) {
+        const auto started = std::find_if(encounters.rbegin(), encounters.rend(), [&](clogparser::Cached_encounter const& encounter) {
+          return !encounter.ended && encounter.encounter_id == event.encounter_id;
+        });
+        if (started != encounters.rend()) {
+          started->end_event = events.size();
+          started->end_time = adding.time;
+          started->success = event.success;
+          started->ended = true;
+        }
+      }
+    }
+
+    std::vector<clogparser::Cached_event> events;
+    clogparser::Unit_table units;
+    std::vector<clogparser::Cached_encounter> encounters;
+    clogparser::Interner strings;
+  };
+
+  struct Writer {
+    template<typename T>
+    Section write(T const* data, std::size_t count) {
+      while (offset % alignof(T) != 0) {
+        out.put('\0');
+        ++offset;
+      }
+      const Section returning{ offset, count };
+      out.write(reinterpret_cast<char const*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+      offset += count * sizeof(T);
+      return returning;
+    }
+
+    std::ofstream& out;
+    std::uint64_t offset;
+  };
+
+  template<typename T>
+  std::span<T const> section(std::string_view file, Section const& in) {
+    if (in.offset % alignof(T) != 0
+      || in.offset > file.size()
+      || in.count > (file.size() - in.offset) / sizeof(T)) {
+      throw std::runtime_error("Combat log cache is truncated");
+    }
+    return { reinterpret_cast<T const*>(file.data() + in.offset), static_cast<std::size_t>(in.count) };
+  }
+}
+
+void clogparser::write_cache(std::filesystem::path const& cache, Mapped_log const& log, Timestamp_decoder timestamps) {
+  Builder builder;
+  {
+    Parser<Builder&> parser{ builder, timestamps };
+    parser.parse_all(log.data());
+  }
+  for (Cached_encounter& encounter : builder.encounters) {
+    if (!encounter.ended) {
+      encounter.end_event = builder.events.size();
+      encounter.end_time = builder.events.back().time;
+    }
+  }
+
+  std::vector<Cached_string> strings;
+  std::string string_data;
+  for (Interner::Id id = 0; id < builder.strings.size(); ++id) {
+    const std::string_view str = builder.strings[id];
+    strings.push_back(Cached_string{ string_data.size(), str.size() });
+    string_data.append(str);
+  }
+
+  std::filesystem::path writing = cache;
+  writing += ".tmp";
+  {
+    std::ofstream out{ writing, std::ios::binary | std::ios::trunc };
+    out.exceptions(std::ios::failbit | std::ios::badbit);
+
+    Header header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.endian = ENDIAN;
+    header.types = types_hash(static_cast<events::Type const*>(nullptr));
+    header.log_size = log.size();
+    header.log_start = internal::hash_start(log.data());
+    out.write(reinterpret_cast<char const*>(&header), sizeof(header)); //filled in once the sections are placed
+
+    Writer writer{ out, sizeof(header) };
+    header.events = writer.write(builder.events.data(), builder.events.size());
+    header.units = writer.write(builder.units.guids().data(), builder.units.size());
+    header.encounters = writer.write(builder.encounters.data(), builder.encounters.size());
+    header.strings = writer.write(strings.data(), strings.size());
+    header.string_data = writer.write(string_data.data(), string_data.size());
+
+    out.seekp(0);
+    out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+  }
+  std::filesystem::rename(writing, cache);
+}
+
+clogparser::Cached_log::Cached_log(std::filesystem::path const& cache, std::filesystem::path const& log) :
+  cache_(cache),
+  log_(log) {
+  const std::string_view file = cache_.data();
+  Header header;
+  if (file.size() < sizeof(header)) {
+    throw std::runtime_error("Combat log cache is truncated");
+  }
+  std::memcpy(&header, file.data(), sizeof(header));
+
+  if (header.magic != MAGIC
+    || header.version != VERSION
+    || header.endian != ENDIAN
+    || header.types != types_hash(static_cast<events::Type const*>(nullptr))) {
+    throw std::runtime_error("Not a combat log cache of this version");
+  }
+  if (header.log_size != log_.size() || header.log_start != internal::hash_start(log_.data())) {
+    throw std::runtime_error("Combat log cache is of a different log");
+  }
+
+  events_ = section<Cached_event>(file, header.events);
+  units_ = section<Guid>(file, header.units);
+  encounters_ = section<Cached_encounter>(file, header.encounters);
+  strings_ = section<Cached_string>(file, header.strings);
+  const auto string_data = section<char>(file, header.string_data);
+  for (Cached_string const& entry : strings_) {
+    if (entry.offset > string_data.size() || entry.size > string_data.size() - entry.offset) {
+      throw std::runtime_error("Combat log cache is truncated");
+    }
+  }
+  string_data_ = string_data.data();
+}
+
+clogparser::Cached_log clogparser::Cached_log::open(std::filesystem::path const& cache, std::filesystem::path const& log) {
+  if (std::filesystem::exists(cache)) {
+    try {
+      return Cached_log{ cache, log };
+    } catch (std::runtime_error const&) {
+      //out of date or unreadable, written again below
+    }
+  }
+  {
+    const Mapped_log mapped{ log };
+    const auto log_start = log_file_date(log.filename().string());
+    write_cache(cache, mapped, log_start ? Timestamp_decoder{ *log_start } : Timestamp_decoder{});
+  }
+  return Cached_log{ cache, log };
+}
+
+std::string_view clogparser::Cached_log::string(std::uint32_t id) const noexcept {
+  const Cached_string entry = strings_[id];
+  return { string_data_ + entry.offset, static_cast<std::size_t>(entry.size) };
+}
+
+std::optional<clogparser::events::Type> clogparser::Cached_log::decode(Cached_event const& event, Bump_arena& arrays) const {
+  const std::string_view data = log_.data();
+  if (event.line >= data.size()) {
+    return std::nullopt;
+  }
+  const std::size_t end = internal::next_line_start(data, static_cast<std::size_t>(event.line) + 1);
+
+  std::optional<events::Type> returning;
+  auto cb = [&returning, &arrays]<typename T>(Timestamp, T const& decoded, std::size_t) requires std::is_constructible_v<events::Type, T> {
+    returning.emplace(internal::keep_arrays(arrays, decoded));
+  };
+  Parser<decltype(cb)&> parser{ cb, Timestamp_decoder::starting_at(Timestamp::from_epoch(Period{ event.time })) };
+  parser.parse_all(data.substr(event.line, end - event.line), event.line);
+  return returning;
+}
@@ -0,0 +1,315 @@
+#include <clogparser/compressed_log.hpp>
+#include <clogparser/scanner.hpp>
+
+#include <array>
+#include <cerrno>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#ifdef CLOGPARSER_HAS_ZLIB
+#include <zlib.h>
+#endif
+#ifdef CLOGPARSER_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace clogparser::internal {
+  //where a Decompressed_log's bytes come from
+  struct Log_source {
+    virtual ~Log_source() = default;
+    //fills up to size bytes of out, returning how many. 0 only at the end
+    virtual std::size_t read(char* out, std::size_t size) = 0;
+  };
+}
+
+namespace {
+  using clogparser::internal::Log_source;
+
+  constexpr std::size_t INPUT_SIZE = std::size_t{ 256 } << 10;
+
+  //fills up to size bytes of out from file, 0 only at its end
+  std::size_t read_file(std::ifstream& file, char* out, std::size_t size) {
+    file.read(out, static_cast<std::streamsize>(size));
+    if (file.bad()) {
+      throw std::runtime_error("Couldn't read combat log");
+    }
+    return static_cast<std::size_t>(file.gcount());
+  }
+
+  struct Plain_source : Log_source {
+    explicit Plain_source(std::ifstream file) :
+      file_(std::move(file)) {
+
+    }
+
+    std::size_t read(char* out, std::size_t size) override {
+      return read_file(file_, out, size);
+    }
+  private:
+    std::ifstream file_;
+  };
+
+#ifdef CLOGPARSER_HAS_ZLIB
+  //every gzip member one after the other, as gunzip does
+  struct Gzip_source : Log_source {
+    explicit Gzip_source(std::ifstream file) :
+      file_(std::move(file)),
+      input_(INPUT_SIZE) {
+      if (inflateInit2(&stream_, 15 + 16) != Z_OK) {
+        throw std::runtime_error("Couldn't start decompressing combat log");
+      }
+    }
+
+    ~Gzip_source() override {
+      inflateEnd(&stream_);
+    }
+
+    std::size_t read(char* out, std::size_t size) override {
+      stream_.next_out = reinterpret_cast<Bytef*>(out);
+      stream_.avail_out = static_cast<uInt>(size);
+      while (stream_.avail_out == size) {
+        if (stream_.avail_in == 0) {
+          stream_.next_in = reinterpret_cast<Bytef*>(input_.data());
+          stream_.avail_in = static_cast<uInt>(read_file(file_, input_.data(), input_.size()));
+          if (stream_.avail_in == 0) {
+            if (in_member_) {
+              throw std::runtime_error("Compressed combat log is truncated");
+            }
+            break;
+          }
+        }
+        in_member_ = true;
+
+        const int result = inflate(&stream_, Z_NO_FLUSH);
+        if (result == Z_STREAM_END) {
+          in_member_ = false;
+          inflateReset(&stream_);
+        } else if (result != Z_OK && result != Z_BUF_ERROR) {
+          throw std::runtime_error("Couldn't decompress combat log");
+        }
+      }
+      return size - stream_.avail_out;
+    }
+  private:
+    std::ifstream file_;
+    std::vector<char> input_;
+    z_stream stream_{};
+    bool in_member_ = false;
+  };
+#endif
+
+#ifdef CLOGPARSER_HAS_ZSTD
+  struct Zstd_source : Log_source {
+    explicit Zstd_source(std::ifstream file) :
+      file_(std::move(file)),
+      input_(INPUT_SIZE),
+      stream_(ZSTD_createDStream()) {
+      if (stream_ == nullptr) {
+        throw std::runtime_error("Couldn't start decompressing combat log");
+      }
+    }
+
+    ~Zstd_source() override {
+      ZSTD_freeDStream(stream_);
+    }
+
+    std::size_t read(char* out, std::size_t size) override {
+      ZSTD_outBuffer output{ out, size, 0 };
+      while (output.pos == 0) {
+        if (in_.pos == in_.size) {
+          in_ = ZSTD_inBuffer{ input_.data(), read_file(file_, input_.data(), input_.size()), 0 };
+          if (in_.size == 0) {
+            if (in_frame_) {
+              throw std::runtime_error("Compressed combat log is truncated");
+            }
+            break;
+          }
+        }
+
+        const std::size_t result = ZSTD_decompressStream(stream_, &output, &in_);
+        if (ZSTD_isError(result)) {
+          throw std::runtime_error(std::string{ "Couldn't decompress combat log: " } + ZSTD_getErrorName(result));
+        }
+        in_frame_ = result != 0;
+      }
+      return output.pos;
+    }
+  private:
+    std::ifstream file_;
+    std::vector<char> input_;
+    ZSTD_DStream* stream_;
+    ZSTD_inBuffer in_{ nullptr, 0, 0 };
+    bool in_frame_ = false;
+  };
+#endif
+
+  std::unique_ptr<Log_source> open_source(std::filesystem::path const& path) {
+    std::ifstream file{ path, std::ios::binary };
+    if (!file) {
+      throw std::system_error(errno, std::generic_category(), "Couldn't open combat log");
+    }
+    std::array<char, 4> magic{};
+    file.read(magic.data(), magic.size());
+    const std::string_view start{ magic.data(), static_cast<std::size_t>(file.gcount()) };
+    file.clear();
+    file.seekg(0);
+
+    const clogparser::Compression compression = clogparser::compression_of(start);
+    if (!clogparser::can_decompress(compression)) {
+      throw std::runtime_error("Combat log is compressed in a format this build can't decompress");
+    }
+    switch (compression) {
+#ifdef CLOGPARSER_HAS_ZLIB
+    case clogparser::Compression::gzip:
+      return std::make_unique<Gzip_source>(std::move(file));
+#endif
+#ifdef CLOGPARSER_HAS_ZSTD
+    case clogparser::Compression::zstd:
+      return std::make_unique<Zstd_source>(std::move(file));
+#endif
+    default:
+      return std::make_unique<Plain_source>(std::move(file));
+    }
+  }
+
+  //one past the last \n in in that isn't inside quotes, 0 if there isn't one
+  std::size_t end_of_lines(std::string_view in) noexcept {
+    std::size_t returning = 0;
+    bool in_quote = false;
+    std::size_t found;
+    while ((found = clogparser::helpers::find_unquoted(in, returning, '\n', '"', in_quote)) != std::string_view::npos) {
+      returning = found + 1;
+    }
+    return returning;
+  }
+}
+
+clogparser::Compression clogparser::compression_of(std::string_view start) noexcept {
+  if (start.starts_with("\x1f\x8b")) {
+    return Compression::gzip;
+  } else if (start.starts_with("\x28\xb5\x2f\xfd")) {
+    return Compression::zstd;
+  }
+  return Compression::none;
+}
+
+bool clogparser::can_decompress(Compression compression) noexcept {
+  switch (compression) {
+  case Compression::none:
+    return true;
+  case Compression::gzip:
+#ifdef CLOGPARSER_HAS_ZLIB
+    return true;
+#else
+    return false;
+#endif
+  case Compression::zstd:
+#ifdef CLOGPARSER_HAS_ZSTD
+    return true;
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+clogparser::Decompressed_log::Decompressed_log(std::filesystem::path const& path, std::size_t buffer_size, std::size_t buffers) :
+  source_(open_source(path)),
+  buffer_size_(buffer_size),
+  buffers_(buffers),
+  sizes_(buffers),
+  handed_out_(buffers) {
+  for (std::size_t i = 0; i < buffers; ++i) {
+    free_.push_back(i);
+  }
+  thread_ = std::thread{ [this]() { decompress_(); } };
+}
+
+clogparser::Decompressed_log::~Decompressed_log() {
+  {
+    std::lock_guard lock{ mutex_ };
+    stopping_ = true;
+  }
+  changed_.notify_all();
+  thread_.join();
+}
+
+std::string_view clogparser::Decompressed_log::next() {
+  std::unique_lock lock{ mutex_ };
+  if (handed_out_ != buffers_.size()) {
+    free_.push_back(std::exchange(handed_out_, buffers_.size()));
+    changed_.notify_all();
+  }
+  changed_.wait(lock, [this]() { return !filled_.empty() || done_; });
+
+  if (!filled_.empty()) {
+    handed_out_ = filled_.front();
+    filled_.pop_front();
+    return { buffers_[handed_out_].data(), sizes_[handed_out_] };
+  }
+  if (error_) {
+    std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+  return {};
+}
+
+void clogparser::Decompressed_log::decompress_() {
+  try {
+    std::string carried; //the start of a line that didn't fit in the last buffer
+    bool ended = false;
+    while (!ended) {
+      std::size_t filling;
+      {
+        std::unique_lock lock{ mutex_ };
+        changed_.wait(lock, [this]() { return !free_.empty() || stopping_; });
+        if (stopping_) {
+          return;
+        }
+        filling = free_.front();
+        free_.pop_front();
+      }
+
+      std::string& buffer = buffers_[filling];
+      buffer.resize(std::max(buffer_size_, carried.size() * 2));
+      buffer.replace(0, carried.size(), carried);
+      std::size_t used = carried.size();
+
+      std::size_t lines = 0;
+      for (;;) {
+        while (used < buffer.size()) {
+          const std::size_t got = source_->read(buffer.data() + used, buffer.size() - used);
+          if (got == 0) {
+            ended = true;
+            break;
+          }
+          used += got;
+        }
+        lines = ended ? used : end_of_lines({ buffer.data(), used });
+        if (lines != 0 || ended) {
+          break;
+        }
+        buffer.resize(buffer.size() * 2); //a line longer than a buffer
+      }
+      carried.assign(buffer, lines, used - lines);
+
+      std::lock_guard lock{ mutex_ };
+      if (lines == 0) {
+        free_.push_back(filling);
+      } else {
+        sizes_[filling] = lines;
+        filled_.push_back(filling);
+      }
+      changed_.notify_all();
+    }
+  } catch (...) {
+    std::lock_guard lock{ mutex_ };
+    error_ = std::current_exception();
+  }
+  {
+    std::lock_guard lock{ mutex_ };
+    done_ = true;
+  }
+  changed_.notify_all();
+}
@@ -0,0 +1,308 @@
+#include <clogparser/encounter_index.hpp>
+#include <clogparser/parallel.hpp>
+#include <clogparser/scanner.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <variant>
+
+namespace events = clogparser::events;
+
+namespace {
+  constexpr std::array<char, 8> MAGIC = { 'C', 'L', 'O', 'G', 'I', 'N', 'D', 'X' };
+  constexpr std::uint32_t VERSION = 1;
+  constexpr std::uint32_t ENDIAN = 0x01020304;
+
+  using Index_filter = clogparser::Event_filter<
+    events::Combat_log_version,
+    events::Zone_change,
+    events::Encounter_start,
+    events::Encounter_end>;
+
+  struct Indexer {
+    void operator()(clogparser::Timestamp, events::Combat_log_version const& event, std::size_t offset) {
+      index.versions.push_back(clogparser::Encounter_index::Version{ offset, event });
+    }
+    void operator()(clogparser::Timestamp, events::Zone_change const& event, std::size_t offset) {
+      index.zones.push_back(clogparser::Encounter_index::Zone{
+        offset,
+        event.instance_id,
+        std::string{ event.zone_name },
+        event.difficulty_id });
+    }
+    void operator()(clogparser::Timestamp time, events::Encounter_start const& event, std::size_t offset) {
+      index.pulls.push_back(clogparser::Encounter_index::Pull{
+        offset,
+        log.size(),
+        time,
+        time,
+        event.encounter_id,
+        std::string{ event.encounter_name },
+        event.difficulty_id,
+        event.instance_size,
+        event.instance_id,
+        false,
+        false,
+        last_(index.zones),
+        last_(index.versions) });
+    }
+    void operator()(clogparser::Timestamp time, events::Encounter_end const& event, std::size_t offset) {
+      const auto started = std::find_if(index.pulls.rbegin(), index.pulls.rend(), [&](clogparser::Encounter_index::Pull const& pull) {
+        return !pull.ended && pull.encounter_id == event.encounter_id;
+      });
+      if (started != index.pulls.rend()) {
+        started->end = clogparser::internal::next_line_start(log, offset + 1);
+        started->end_time = time;
+        started->success = event.success;
+        started->ended = true;
+      }
+    }
+
+    std::string_view log;
+    clogparser::Encounter_index& index;
+  private:
+    template<typename T>
+    static std::size_t last_(std::vector<T> const& in) noexcept {
+      return in.empty() ? clogparser::Encounter_index::NONE : in.size() - 1;
+    }
+  };
+
+  //the first letter of each of Index_filter's event names
+  template<typename... Ts>
+  std::string leads_of(std::variant<Ts...> const*) {
+    std::string returning;
+    for (const std::string_view name : { std::string_view{ Ts::NAME }... }) {
+      if (returning.find(name.front()) == std::string::npos) {
+        returning.push_back(name.front());
+      }
+    }
+    return returning;
+  }
+
+  template<typename... Ts>
+  bool is_indexed(std::string_view event, std::variant<Ts...> const*) noexcept {
+    return ((event.starts_with(Ts::NAME) && event.substr(std::string_view{ Ts::NAME }.size()).starts_with(',')) || ...);
+  }
+
+  //where the line whose event name starts at name_start begins, npos if what's before
+  //name_start can't be a timestamp and its two spaces. the parser checks the timestamp
+  std::size_t line_start_of(std::string_view log, std::size_t name_start) noexcept {
+    constexpr std::size_t MAX_TIMESTAMP = 48;
+    const std::size_t separator = name_start - 2;
+    const std::size_t searching = separator > MAX_TIMESTAMP ? separator - MAX_TIMESTAMP : 0;
+
+    std::size_t on = separator;
+    while (on > searching && log[on - 1] != '\n') {
+      const char c = log[on - 1];
+      if (!(c >= '0' && c <= '9') && c != '/' && c != ':' && c != '.' && c != ' ' && c != '-' && c != '+') {
+        return std::string_view::npos;
+      }
+      --on;
+    }
+    return on == 0 || log[on - 1] == '\n' ? on : std::string_view::npos;
+  }
+
+  struct Writer {
+    template<typename T> requires std::is_trivially_copyable_v<T>
+    void put(T const& value) {
+      out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+    void put(std::string const& value) {
+      put(static_cast<std::uint64_t>(value.size()));
+      out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    std::ofstream& out;
+  };
+
+  //each get is false once in runs out
+  struct Reader {
+    template<typename T> requires std::is_trivially_copyable_v<T>
+    bool get(T& value) noexcept {
+      if (in.size() < sizeof(T)) {
+        return false;
+      }
+      std::memcpy(&value, in.data(), sizeof(T));
+      in.remove_prefix(sizeof(T));
+      return true;
+    }
+    bool get(std::string& value) {
+      std::uint64_t size;
+      if (!get(size) || size > in.size()) {
+        return false;
+      }
+      value.assign(in.substr(0, static_cast<std::size_t>(size)));
+      in.remove_prefix(static_cast<std::size_t>(size));
+      return true;
+    }
+
+    std::string_view in;
+  };
+}
+
+clogparser::Encounter_index clogparser::index_encounters(std::string_view log, Timestamp_decoder timestamps) {
+  Encounter_index returning;
+  returning.log_size = log.size();
+  returning.log_start = internal::hash_start(log);
+
+  //only the lines of the indexed events are parsed, found by their name after the
+  //timestamp's two spaces, so the rest of the log is only looked at 64 bytes at a time
+  static const std::string leads = leads_of(static_cast<Index_filter::Types const*>(nullptr));
+
+  Parser<Indexer, Index_filter> parser{ Indexer{ log, returning }, timestamps };
+  std::size_t on = 0;
+  while ((on = helpers::find_event_start(log, on, leads)) != std::string_view::npos) {
+    const std::size_t line = line_start_of(log, on);
+    if (line == std::string_view::npos || !is_indexed(log.substr(on), static_cast<Index_filter::Types const*>(nullptr))) {
+      ++on;
+      continue;
+    }
+    bool in_quote = false;
+    const std::size_t newline = helpers::find_unquoted(log, on, '\n', '"', in_quote);
+    const std::size_t end = newline == std::string_view::npos ? log.size() : newline + 1;
+    parser.parse_all(log.substr(line, end - line), line);
+    on = end;
+  }
+  return returning;
+}
+
+void clogparser::write_index(std::filesystem::path const& path, Encounter_index const& index) {
+  std::filesystem::path writing = path;
+  writing += ".tmp";
+  try {
+    std::ofstream out{ writing, std::ios::binary | std::ios::trunc };
+    out.exceptions(std::ios::failbit | std::ios::badbit);
+    Writer writer{ out };
+
+    writer.put(MAGIC);
+    writer.put(VERSION);
+    writer.put(ENDIAN);
+    writer.put(index.log_size);
+    writer.put(index.log_start);
+
+    writer.put(static_cast<std::uint64_t>(index.versions.size()));
+    for (Encounter_index::Version const& version : index.versions) {
+      writer.put(version.offset);
+      writer.put(version.version);
+    }
+    writer.put(static_cast<std::uint64_t>(index.zones.size()));
+    for (Encounter_index::Zone const& zone : index.zones) {
+      writer.put(zone.offset);
+      writer.put(zone.instance_id);
+      writer.put(zone.name);
+      writer.put(zone.difficulty_id);
+    }
+    writer.put(static_cast<std::uint64_t>(index.pulls.size()));
+    for (Encounter_index::Pull const& pull : index.pulls) {
+      writer.put(pull.begin);
+      writer.put(pull.end);
+      writer.put(pull.start_time);
+      writer.put(pull.end_time);
+      writer.put(pull.encounter_id);
+      writer.put(pull.name);
+      writer.put(pull.difficulty_id);
+      writer.put(pull.instance_size);
+      writer.put(pull.instance_id);
+      writer.put(pull.ended);
+      writer.put(pull.success);
+      writer.put(static_cast<std::uint64_t>(pull.zone));
+      writer.put(static_cast<std::uint64_t>(pull.version));
+    }
+  } catch (std::system_error const&) {
+    std::error_code ignored;
+    std::filesystem::remove(writing, ignored);
+    throw;
+  }
+  std::filesystem::rename(writing, path);
+}
+
+std::optional<clogparser::Encounter_index> clogparser::read_index(std::filesystem::path const& path) {
+  std::ifstream file{ path, std::ios::binary | std::ios::ate };
+  if (!file) {
+    return std::nullopt;
+  }
+  std::string contents(static_cast<std::size_t>(file.tellg()), '\0');
+  file.seekg(0);
+  if (!file.read(contents.data(), static_cast<std::streamsize>(contents.size()))) {
+    return std::nullopt;
+  }
+  Reader reader{ contents };
+
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t endian;
+  if (!reader.get(magic) || !reader.get(version) || !reader.get(endian)
+    || magic != MAGIC || version != VERSION || endian != ENDIAN) {
+    return std::nullopt;
+  }
+
+  Encounter_index returning;
+  if (!reader.get(returning.log_size) || !reader.get(returning.log_start)) {
+    return std::nullopt;
+  }
+
+  std::uint64_t count;
+  if (!reader.get(count)) {
+    return std::nullopt;
+  }
+  for (; count > 0; --count) {
+    Encounter_index::Version& reading = returning.versions.emplace_back();
+    if (!reader.get(reading.offset) || !reader.get(reading.version)) {
+      return std::nullopt;
+    }
+  }
+  if (!reader.get(count)) {
+    return std::nullopt;
+  }
+  for (; count > 0; --count) {
+    Encounter_index::Zone& reading = returning.zones.emplace_back();
+    if (!reader.get(reading.offset) || !reader.get(reading.instance_id)
+      || !reader.get(reading.name) || !reader.get(reading.difficulty_id)) {
+      return std::nullopt;
+    }
+  }
+  if (!reader.get(count)) {
+    return std::nullopt;
+  }
+  for (; count > 0; --count) {
+    Encounter_index::Pull& reading = returning.pulls.emplace_back();
+    std::uint64_t zone;
+    std::uint64_t version_on;
+    if (!reader.get(reading.begin) || !reader.get(reading.end)
+      || !reader.get(reading.start_time) || !reader.get(reading.end_time)
+      || !reader.get(reading.encounter_id) || !reader.get(reading.name)
+      || !reader.get(reading.difficulty_id) || !reader.get(reading.instance_size)
+      || !reader.get(reading.instance_id) || !reader.get(reading.ended)
+      || !reader.get(reading.success) || !reader.get(zone)
+      || !reader.get(version_on)) {
+      return std::nullopt;
+    }
+    reading.zone = static_cast<std::size_t>(zone);
+    reading.version = static_cast<std::size_t>(version_on);
+  }
+  return returning;
+}
+
+clogparser::Encounter_index clogparser::index_file(std::filesystem::path const& path, Mapped_log const& log) {
+  std::filesystem::path sidecar = path;
+  sidecar += ".encounters";
+
+  std::optional<Encounter_index> read = read_index(sidecar);
+  if (read && read->log_size == log.size() && read->log_start == internal::hash_start(log.data())) {
+    return std::move(*read);
+  }
+
+  const auto log_start = log_file_date(path.filename().string());
+  Encounter_index returning = index_encounters(log.data(), log_start ? Timestamp_decoder{ *log_start } : Timestamp_decoder{});
+  try {
+    write_index(sidecar, returning);
+  } catch (std::system_error const&) {
+    //the log's directory can't be written to, it's indexed again next time
+  }
+  return returning;
+}
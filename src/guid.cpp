@@ -0,0 +1,210 @@
+#include <clogparser/guid.hpp>
+
+#include <array>
+#include <algorithm>
+
+namespace {
+  using Type = clogparser::Guid::Type;
+
+  struct Shape {
+    std::string_view name;
+    Type type;
+  };
+
+  constexpr std::array<Shape, 10> SHAPES = { {
+    { "Player", Type::player },
+    { "Creature", Type::creature },
+    { "Pet", Type::pet },
+    { "GameObject", Type::game_object },
+    { "Vehicle", Type::vehicle },
+    { "Vignette", Type::vignette },
+    { "AreaTrigger", Type::area_trigger },
+    { "Cast", Type::cast },
+    { "Item", Type::item },
+    { "BattlePet", Type::battle_pet }
+  } };
+
+  constexpr std::string_view NONE = "0000000000000000";
+
+  //hex digits of the last field, always zero padded to this width
+  constexpr std::size_t hex_width(Type type) noexcept {
+    switch (type) {
+    case Type::player:
+      return 8;
+    case Type::item:
+      return 16;
+    case Type::battle_pet:
+      return 12;
+    default:
+      return 10;
+    }
+  }
+
+  //pops the field up to the next - off in
+  std::string_view next_field(std::string_view& in) noexcept {
+    const std::size_t dash = in.find('-');
+    const std::string_view returning = in.substr(0, dash);
+    in.remove_prefix(dash == std::string_view::npos ? in.size() : dash + 1);
+    return returning;
+  }
+
+  //only the way they're printed, so without leading zeroes
+  bool read_decimal(std::string_view in, std::uint64_t max, std::uint64_t& returning) noexcept {
+    if (in.empty() || in.size() > 10 || (in.size() > 1 && in[0] == '0')) {
+      return false;
+    }
+    returning = 0;
+    for (const char c : in) {
+      if (c < '0' || c > '9') {
+        return false;
+      }
+      returning = returning * 10 + static_cast<std::uint64_t>(c - '0');
+    }
+    return returning <= max;
+  }
+
+  bool read_hex(std::string_view in, std::size_t width, std::uint64_t& returning) noexcept {
+    if (in.size() != width) {
+      return false;
+    }
+    returning = 0;
+    for (const char c : in) {
+      std::uint64_t digit;
+      if (c >= '0' && c <= '9') {
+        digit = static_cast<std::uint64_t>(c - '0');
+      } else if (c >= 'A' && c <= 'F') {
+        digit = static_cast<std::uint64_t>(c - 'A' + 10);
+      } else {
+        return false;
+      }
+      returning = (returning << 4) | digit;
+    }
+    return true;
+  }
+
+  //64 bits of FNV-1a of in from seed, mixed as splitmix64 does so every bit depends on all of in
+  std::uint64_t hash_text(std::string_view in, std::uint64_t seed) noexcept {
+    std::uint64_t returning = seed;
+    for (const char c : in) {
+      returning = (returning ^ static_cast<unsigned char>(c)) * 0x100000001B3;
+    }
+    returning = (returning ^ (returning >> 30)) * 0xBF58476D1CE4E5B9;
+    returning = (returning ^ (returning >> 27)) * 0x94D049BB133111EB;
+    return returning ^ (returning >> 31);
+  }
+
+  constexpr std::string_view UNKNOWN = "Unknown";
+  constexpr std::uint64_t UNKNOWN_HI_MASK = (std::uint64_t{ 1 } << clogparser::Guid::TYPE_SHIFT) - 1;
+
+  void write_hex(std::string& out, std::uint64_t value, std::size_t width) {
+    constexpr std::string_view DIGITS = "0123456789ABCDEF";
+    const std::size_t start = out.size();
+    out.resize(start + width);
+    for (std::size_t i = width; i-- > 0;) {
+      out[start + i] = DIGITS[value & 0xF];
+      value >>= 4;
+    }
+  }
+}
+
+std::optional<clogparser::Guid> clogparser::Guid::parse(std::string_view in) noexcept {
+  if (in.empty() || in == NONE) {
+    return Guid{};
+  }
+
+  const std::string_view name = next_field(in);
+  const auto shape = std::find_if(SHAPES.begin(), SHAPES.end(), [name](Shape const& s) { return s.name == name; });
+  if (shape == SHAPES.end()) {
+    return std::nullopt;
+  }
+  const Type type = shape->type;
+
+  std::uint64_t subtype = 0;
+  std::uint64_t server_id = 0;
+  std::uint64_t instance_id = 0;
+  std::uint64_t zone_uid = 0;
+  std::uint64_t id = 0;
+  std::uint64_t spawn_uid = 0;
+
+  bool read;
+  switch (type) {
+  case Type::player:
+    read = read_decimal(next_field(in), SERVER_ID_MASK, server_id);
+    break;
+  case Type::item:
+    read = read_decimal(next_field(in), SERVER_ID_MASK, server_id)
+      && read_decimal(next_field(in), SUBTYPE_MASK, subtype);
+    break;
+  case Type::battle_pet:
+    read = read_decimal(next_field(in), SUBTYPE_MASK, subtype);
+    break;
+  default:
+    read = read_decimal(next_field(in), SUBTYPE_MASK, subtype)
+      && read_decimal(next_field(in), SERVER_ID_MASK, server_id)
+      && read_decimal(next_field(in), INSTANCE_ID_MASK, instance_id)
+      && read_decimal(next_field(in), 0xFFFFFF, zone_uid)
+      && read_decimal(next_field(in), ID_MASK, id);
+    break;
+  }
+  //what's left has to be exactly the last field
+  if (!read || in.find('-') != std::string_view::npos || !read_hex(in, hex_width(type), spawn_uid)) {
+    return std::nullopt;
+  }
+
+  return Guid{
+    (static_cast<std::uint64_t>(type) << TYPE_SHIFT)
+      | (subtype << SUBTYPE_SHIFT)
+      | (server_id << SERVER_ID_SHIFT)
+      | (instance_id << INSTANCE_ID_SHIFT)
+      | id,
+    (zone_uid << ZONE_UID_SHIFT) | spawn_uid };
+}
+
+clogparser::Guid clogparser::Guid::opaque(std::string_view in) noexcept {
+  return Guid{
+    (static_cast<std::uint64_t>(Type::unknown) << TYPE_SHIFT) | (hash_text(in, 0xCBF29CE484222325) & UNKNOWN_HI_MASK),
+    hash_text(in, 0x84222325CBF29CE4) };
+}
+
+std::string clogparser::to_string(Guid guid) {
+  const Type type = guid.type();
+  if (type == Type::none) {
+    return std::string{ NONE };
+  }
+  if (type == Type::unknown) {
+    std::string returning{ UNKNOWN };
+    returning += '-';
+    write_hex(returning, guid.hi() & UNKNOWN_HI_MASK, 15);
+    write_hex(returning, guid.lo(), 16);
+    return returning;
+  }
+
+  std::string returning{ SHAPES[static_cast<std::size_t>(type) - 1].name };
+  auto field = [&](std::uint64_t value) {
+    returning += '-';
+    returning += std::to_string(value);
+  };
+
+  switch (type) {
+  case Type::player:
+    field(guid.server_id());
+    break;
+  case Type::item:
+    field(guid.server_id());
+    field(guid.subtype());
+    break;
+  case Type::battle_pet:
+    field(guid.subtype());
+    break;
+  default:
+    field(guid.subtype());
+    field(guid.server_id());
+    field(guid.instance_id());
+    field(guid.zone_uid());
+    field(guid.id());
+    break;
+  }
+  returning += '-';
+  write_hex(returning, guid.spawn_uid(), hex_width(type));
+  return returning;
+}
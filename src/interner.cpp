@@ -0,0 +1,164 @@
+#include <clogparser/interner.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <functional>
+
+std::uint32_t clogparser::Interner::hash(std::string_view in) noexcept {
+  const std::size_t hash = std::hash<std::string_view>{}(in);
+  return static_cast<std::uint32_t>(hash ^ (static_cast<std::uint64_t>(hash) >> 32));
+}
+
+//the entry holding in, or the empty one it would go in. the table is never full
+std::size_t clogparser::Interner::find_slot_(std::string_view in, std::uint32_t hash) const noexcept {
+  const std::size_t mask = table_.size() - 1;
+  for (std::size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+    Entry const& entry = table_[slot];
+    if (entry.id_plus_one == 0
+      || (entry.hash == hash && strings_[entry.id_plus_one - 1] == in)) {
+      return slot;
+    }
+  }
+}
+
+clogparser::Interner::Interned clogparser::Interner::intern(std::string_view in) {
+  return intern(in, hash(in));
+}
+
+clogparser::Interner::Interned clogparser::Interner::intern(std::string_view in, std::uint32_t hash) {
+  if (table_.empty()) {
+    table_.resize(1024);
+  }
+
+  std::size_t slot = find_slot_(in, hash);
+  if (table_[slot].id_plus_one != 0) {
+    const Id id = table_[slot].id_plus_one - 1;
+    return { strings_[id], id };
+  }
+
+  //keep the table at most half full
+  if ((strings_.size() + 1) * 2 > table_.size()) {
+    grow_();
+    slot = find_slot_(in, hash);
+  }
+
+  const Id id = static_cast<Id>(strings_.size());
+  const std::string_view copied{ copy_(in), in.size() };
+  strings_.push_back(copied);
+  table_[slot] = Entry{ hash, id + 1 };
+  return { copied, id };
+}
+
+std::optional<clogparser::Interner::Id> clogparser::Interner::find(std::string_view in) const noexcept {
+  if (table_.empty()) {
+    return std::nullopt;
+  }
+  const Entry& entry = table_[find_slot_(in, hash(in))];
+  if (entry.id_plus_one == 0) {
+    return std::nullopt;
+  }
+  return entry.id_plus_one - 1;
+}
+
+void clogparser::Interner::clear() noexcept {
+  blocks_.clear();
+  block_on_ = nullptr;
+  block_left_ = 0;
+  strings_.clear();
+  table_.clear();
+}
+
+char const* clogparser::Interner::copy_(std::string_view in) {
+  if (in.size() > BLOCK_SIZE / 4) { //big strings get a block of their own
+    blocks_.push_back(std::make_unique_for_overwrite<char[]>(in.size()));
+    std::copy(in.begin(), in.end(), blocks_.back().get());
+    return blocks_.back().get();
+  }
+  if (in.size() > block_left_) {
+    blocks_.push_back(std::make_unique_for_overwrite<char[]>(BLOCK_SIZE));
+    block_on_ = blocks_.back().get();
+    block_left_ = BLOCK_SIZE;
+  }
+  char* returning = block_on_;
+  std::copy(in.begin(), in.end(), returning);
+  block_on_ += in.size();
+  block_left_ -= in.size();
+  return returning;
+}
+
+void clogparser::Interner::grow_() {
+  std::vector<Entry> old(table_.size() * 2);
+  old.swap(table_);
+
+  const std::size_t mask = table_.size() - 1;
+  for (Entry const& entry : old) {
+    if (entry.id_plus_one == 0) {
+      continue;
+    }
+    std::size_t slot = entry.hash & mask;
+    while (table_[slot].id_plus_one != 0) {
+      slot = (slot + 1) & mask;
+    }
+    table_[slot] = entry;
+  }
+}
+
+namespace {
+  std::atomic<std::uint64_t> next_generation{ 1 };
+
+  struct Cached {
+    std::uint64_t generation = 0;
+    std::uint32_t hash = 0;
+    std::string_view str;
+  };
+
+  //direct mapped by hash, shared by every Concurrent_interner this thread uses
+  thread_local std::array<Cached, 256> cache;
+}
+
+clogparser::Concurrent_interner::Concurrent_interner(std::size_t shards) :
+  shard_bits_(static_cast<unsigned>(std::countr_zero(std::bit_ceil(std::clamp<std::size_t>(shards, 1, 256))))),
+  generation_(next_generation.fetch_add(1)) {
+  shards_ = std::make_unique<Shard[]>(std::size_t{ 1 } << shard_bits_);
+}
+
+//the top bits pick the shard, the shard's table uses the bottom ones
+clogparser::Concurrent_interner::Shard& clogparser::Concurrent_interner::shard_(std::uint32_t hash) noexcept {
+  return shards_[shard_bits_ == 0 ? 0 : hash >> (32 - shard_bits_)];
+}
+
+std::string_view clogparser::Concurrent_interner::intern(std::string_view in) {
+  const std::uint32_t hash = Interner::hash(in);
+  Cached& cached = cache[hash % cache.size()];
+  if (cached.generation == generation_ && cached.hash == hash && cached.str == in) {
+    return cached.str;
+  }
+
+  Shard& shard = shard_(hash);
+  std::string_view returning;
+  {
+    std::lock_guard lock{ shard.mutex };
+    returning = shard.strings.intern(in, hash).str;
+  }
+  cached = Cached{ generation_, hash, returning };
+  return returning;
+}
+
+std::size_t clogparser::Concurrent_interner::size() const {
+  std::size_t returning = 0;
+  for (std::size_t i = 0; i < (std::size_t{ 1 } << shard_bits_); ++i) {
+    std::lock_guard lock{ shards_[i].mutex };
+    returning += shards_[i].strings.size();
+  }
+  return returning;
+}
+
+void clogparser::Concurrent_interner::clear() {
+  for (std::size_t i = 0; i < (std::size_t{ 1 } << shard_bits_); ++i) {
+    std::lock_guard lock{ shards_[i].mutex };
+    shards_[i].strings.clear();
+  }
+  generation_ = next_generation.fetch_add(1);
+}
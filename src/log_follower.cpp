@@ -0,0 +1,267 @@
+#include <clogparser/log_follower.hpp>
+
+#include <algorithm>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+#endif
+
+namespace {
+  constexpr std::size_t BUFFER_SIZE = std::size_t{ 1 } << 20;
+
+  bool is_log_name(std::string_view name) noexcept {
+    return name.starts_with("WoWCombatLog") && name.ends_with(".txt");
+  }
+
+  //the most recently written log in directory, empty if there isn't one
+  std::filesystem::path newest_log(std::filesystem::path const& directory) {
+    std::filesystem::path returning;
+    std::filesystem::file_time_type returning_time;
+
+    std::error_code error;
+    for (std::filesystem::directory_iterator on{ directory, error }, end; !error && on != end; on.increment(error)) {
+      if (!is_log_name(on->path().filename().string()) || !on->is_regular_file(error)) {
+        continue;
+      }
+      const auto time = on->last_write_time(error);
+      if (error) {
+        error.clear(); //it went away while we were looking
+        continue;
+      }
+      if (returning.empty() || time > returning_time || (time == returning_time && on->path() > returning)) {
+        returning = on->path();
+        returning_time = time;
+      }
+    }
+    return returning;
+  }
+
+#ifdef _WIN32
+  void* open_log(std::filesystem::path const& path) noexcept {
+    void* file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    return file == INVALID_HANDLE_VALUE ? nullptr : file;
+  }
+
+  bool same_file(void* file, std::filesystem::path const& path) noexcept {
+    void* other = open_log(path);
+    if (other == nullptr) {
+      return false;
+    }
+    BY_HANDLE_FILE_INFORMATION file_info;
+    BY_HANDLE_FILE_INFORMATION other_info;
+    const bool returning = GetFileInformationByHandle(file, &file_info)
+      && GetFileInformationByHandle(other, &other_info)
+      && file_info.dwVolumeSerialNumber == other_info.dwVolumeSerialNumber
+      && file_info.nFileIndexHigh == other_info.nFileIndexHigh
+      && file_info.nFileIndexLow == other_info.nFileIndexLow;
+    CloseHandle(other);
+    return returning;
+  }
+#else
+  bool same_file(int file, std::filesystem::path const& path) noexcept {
+    struct stat file_info;
+    struct stat path_info;
+    return ::fstat(file, &file_info) == 0
+      && ::stat(path.c_str(), &path_info) == 0
+      && file_info.st_dev == path_info.st_dev
+      && file_info.st_ino == path_info.st_ino;
+  }
+#endif
+}
+
+clogparser::Log_tail::Log_tail(std::filesystem::path directory, Start start) :
+  directory_(std::move(directory)),
+  start_(start),
+  buffer_(BUFFER_SIZE) {
+#ifdef __linux__
+  watch_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (watch_ < 0) {
+    throw std::system_error(errno, std::generic_category(), "Couldn't watch combat log directory");
+  }
+  if (::inotify_add_watch(watch_, directory_.c_str(), IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE) < 0) {
+    const int error = errno;
+    ::close(watch_);
+    throw std::system_error(error, std::generic_category(), "Couldn't watch combat log directory");
+  }
+#else
+  if (!std::filesystem::is_directory(directory_)) {
+    throw std::system_error(std::make_error_code(std::errc::not_a_directory), "Couldn't watch combat log directory");
+  }
+#endif
+}
+
+clogparser::Log_tail::~Log_tail() {
+  close_();
+#ifdef __linux__
+  ::close(watch_);
+#endif
+}
+
+void clogparser::Log_tail::wait(std::chrono::milliseconds timeout) {
+#ifdef __linux__
+  pollfd polling{ watch_, POLLIN, 0 };
+  if (::poll(&polling, 1, static_cast<int>(timeout.count())) <= 0) {
+    return;
+  }
+
+  alignas(inotify_event) char events[4096];
+  ssize_t got;
+  while ((got = ::read(watch_, events, sizeof(events))) > 0) {
+    for (char const* on = events; on < events + got;) {
+      inotify_event const& event = *reinterpret_cast<inotify_event const*>(on);
+      //writes to the log only need a read, a log coming or going needs a look for the newest
+      if ((event.mask & (IN_CREATE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_Q_OVERFLOW)) != 0
+        && (event.len == 0 || is_log_name(event.name))) {
+        rescan_ = true;
+      }
+      on += sizeof(inotify_event) + event.len;
+    }
+  }
+#else
+  //without change notifications the directory is looked at again after every wait
+  std::this_thread::sleep_for(timeout);
+  rescan_ = true;
+#endif
+}
+
+clogparser::Log_tail::Read clogparser::Log_tail::read() {
+  std::uint64_t size = is_open_() ? size_() : 0;
+  //what's left of the log being read comes before a newer one, so lines written to it
+  //just before the newer one showed up aren't lost
+  if (rescan_ && size <= offset_) {
+    rescan_ = false;
+    open_newest_();
+    size = is_open_() ? size_() : 0;
+  }
+
+  Read returning{ {}, offset_, false };
+  if (!is_open_()) {
+    return returning;
+  }
+
+  if (size < offset_) { //truncated, it's being written again from the start
+    offset_ = 0;
+    restarted_ = true;
+  }
+  returning.offset = offset_;
+  returning.restarted = std::exchange(restarted_, false);
+  if (size == offset_) {
+    return returning;
+  }
+
+  const std::size_t got = read_at_(offset_, static_cast<std::size_t>(std::min<std::uint64_t>(size - offset_, buffer_.size())));
+  offset_ += got;
+  returning.data = { buffer_.data(), got };
+  return returning;
+}
+
+void clogparser::Log_tail::open_newest_() {
+  std::filesystem::path newest = newest_log(directory_);
+  if (newest.empty()) {
+    return;
+  }
+  if (is_open_() && newest == path_ && same_file(file_, path_)) {
+    return;
+  }
+  close_();
+#ifdef _WIN32
+  file_ = open_log(newest);
+  if (file_ == nullptr) {
+#else
+  file_ = ::open(newest.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file_ < 0) {
+#endif
+    rescan_ = true; //gone again already, or not readable yet
+    return;
+  }
+
+  path_ = std::move(newest);
+  offset_ = 0;
+  restarted_ = true;
+  if (start_ == Start::end) {
+    //back to the start of the line being written, so it's parsed once it's finished
+    const std::uint64_t size = size_();
+    const std::size_t tail = static_cast<std::size_t>(std::min<std::uint64_t>(size, buffer_.size()));
+    const std::size_t got = read_at_(size - tail, tail);
+    const std::string_view read{ buffer_.data(), got };
+    const std::size_t newline = read.rfind('\n');
+    offset_ = newline == std::string_view::npos ? size : size - tail + newline + 1;
+  }
+  start_ = Start::beginning; //logs after the first are read from their start
+}
+
+#ifdef _WIN32
+std::uint64_t clogparser::Log_tail::size_() const {
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file_, &size)) {
+    throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Couldn't get size of combat log");
+  }
+  return static_cast<std::uint64_t>(size.QuadPart);
+}
+
+std::size_t clogparser::Log_tail::read_at_(std::uint64_t offset, std::size_t size) {
+  OVERLAPPED at{};
+  at.Offset = static_cast<DWORD>(offset);
+  at.OffsetHigh = static_cast<DWORD>(offset >> 32);
+  DWORD got = 0;
+  if (!ReadFile(file_, buffer_.data(), static_cast<DWORD>(size), &got, &at) && GetLastError() != ERROR_HANDLE_EOF) {
+    throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Couldn't read combat log");
+  }
+  return static_cast<std::size_t>(got);
+}
+
+bool clogparser::Log_tail::is_open_() const noexcept {
+  return file_ != nullptr;
+}
+
+void clogparser::Log_tail::close_() noexcept {
+  if (file_ != nullptr) {
+    CloseHandle(file_);
+  }
+  file_ = nullptr;
+}
+#else
+std::uint64_t clogparser::Log_tail::size_() const {
+  struct stat info;
+  if (::fstat(file_, &info) != 0) {
+    throw std::system_error(errno, std::generic_category(), "Couldn't get size of combat log");
+  }
+  return static_cast<std::uint64_t>(info.st_size);
+}
+
+std::size_t clogparser::Log_tail::read_at_(std::uint64_t offset, std::size_t size) {
+  ssize_t got;
+  do {
+    got = ::pread(file_, buffer_.data(), size, static_cast<off_t>(offset));
+  } while (got < 0 && errno == EINTR);
+  if (got < 0) {
+    throw std::system_error(errno, std::generic_category(), "Couldn't read combat log");
+  }
+  return static_cast<std::size_t>(got);
+}
+
+bool clogparser::Log_tail::is_open_() const noexcept {
+  return file_ >= 0;
+}
+
+void clogparser::Log_tail::close_() noexcept {
+  if (file_ >= 0) {
+    ::close(file_);
+  }
+  file_ = -1;
+}
+#endif
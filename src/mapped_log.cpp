@@ -0,0 +1,151 @@
+#include <clogparser/mapped_log.hpp>
+
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+clogparser::Mapped_log::Mapped_log(std::filesystem::path const& path) {
+  file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file_ == INVALID_HANDLE_VALUE) {
+    file_ = nullptr;
+    throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Couldn't open combat log");
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file_, &size)) {
+    const auto error = static_cast<int>(GetLastError());
+    close_();
+    throw std::system_error(error, std::system_category(), "Couldn't get size of combat log");
+  }
+  size_ = static_cast<std::size_t>(size.QuadPart);
+  if (size_ == 0) { //can't map an empty file
+    return;
+  }
+
+  mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping_ == nullptr) {
+    const auto error = static_cast<int>(GetLastError());
+    close_();
+    throw std::system_error(error, std::system_category(), "Couldn't create mapping of combat log");
+  }
+
+  data_ = static_cast<char const*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+  if (data_ == nullptr) {
+    const auto error = static_cast<int>(GetLastError());
+    close_();
+    throw std::system_error(error, std::system_category(), "Couldn't map combat log");
+  }
+}
+
+void clogparser::Mapped_log::close_() noexcept {
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_ != nullptr) {
+    CloseHandle(mapping_);
+  }
+  if (file_ != nullptr) {
+    CloseHandle(file_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  mapping_ = nullptr;
+  file_ = nullptr;
+}
+
+clogparser::Mapped_log::Mapped_log(Mapped_log&& other) noexcept :
+  data_(std::exchange(other.data_, nullptr)),
+  size_(std::exchange(other.size_, 0)),
+  file_(std::exchange(other.file_, nullptr)),
+  mapping_(std::exchange(other.mapping_, nullptr)) {
+
+}
+
+clogparser::Mapped_log& clogparser::Mapped_log::operator=(Mapped_log&& other) noexcept {
+  if (this != &other) {
+    close_();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    file_ = std::exchange(other.file_, nullptr);
+    mapping_ = std::exchange(other.mapping_, nullptr);
+  }
+  return *this;
+}
+#else
+clogparser::Mapped_log::Mapped_log(std::filesystem::path const& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), "Couldn't open combat log");
+  }
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    const int error = errno;
+    ::close(fd);
+    throw std::system_error(error, std::generic_category(), "Couldn't get size of combat log");
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_ == 0) { //can't map an empty file
+    ::close(fd);
+    return;
+  }
+
+  void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  const int error = errno;
+  ::close(fd); //the mapping keeps its own reference to the file
+  if (mapped == MAP_FAILED) {
+    size_ = 0;
+    throw std::system_error(error, std::generic_category(), "Couldn't map combat log");
+  }
+  ::madvise(mapped, size_, MADV_SEQUENTIAL);
+  data_ = static_cast<char const*>(mapped);
+}
+
+void clogparser::Mapped_log::close_() noexcept {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+}
+
+clogparser::Mapped_log::Mapped_log(Mapped_log&& other) noexcept :
+  data_(std::exchange(other.data_, nullptr)),
+  size_(std::exchange(other.size_, 0)) {
+
+}
+
+clogparser::Mapped_log& clogparser::Mapped_log::operator=(Mapped_log&& other) noexcept {
+  if (this != &other) {
+    close_();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+#endif
+
+clogparser::Mapped_log::~Mapped_log() {
+  close_();
+}
+
+std::uint64_t clogparser::internal::hash_start(std::string_view log) noexcept {
+  constexpr std::size_t START_BYTES = std::size_t{ 64 } << 10;
+  std::uint64_t hash = 14695981039346656037ull;
+  for (const char c : log.substr(0, START_BYTES)) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+  }
+  return hash;
+}
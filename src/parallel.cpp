@@ -0,0 +1,41 @@
+#include <clogparser/parallel.hpp>
+
+namespace {
+  //whether at starts with a timestamp and the two spaces after it
+  bool starts_line(std::string_view at) noexcept {
+    const auto end_timestamp = at.substr(0, 48).find("  ");
+    if (end_timestamp == std::string_view::npos) {
+      return false;
+    }
+    clogparser::Timestamp_decoder decoder;
+    clogparser::Parse_error error = clogparser::Parse_error::none;
+    return decoder.decode(at.substr(0, end_timestamp), error).has_value();
+  }
+}
+
+std::size_t clogparser::internal::next_line_start(std::string_view log, std::size_t from) noexcept {
+  if (from == 0) {
+    return 0;
+  }
+  std::size_t on = from - 1; //from is a line start when the \n is just before it
+  for (;;) {
+    const auto found = log.find('\n', on);
+    if (found == std::string_view::npos || found + 1 == log.size()) {
+      return log.size();
+    }
+    if (starts_line(log.substr(found + 1))) {
+      return found + 1;
+    }
+    on = found + 1;
+  }
+}
+
+std::vector<std::size_t> clogparser::internal::chunk_starts(std::string_view log, std::size_t chunk_size) {
+  std::vector<std::size_t> returning;
+  returning.push_back(0);
+  while (returning.back() < log.size()) {
+    const std::size_t target = returning.back() + std::min(chunk_size, log.size() - returning.back());
+    returning.push_back(next_line_start(log, target));
+  }
+  return returning;
+}
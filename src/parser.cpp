@@ -3,11 +3,21 @@
 #include <array>
 #include <string_view>
 #include <cstdint>
-#include <stdexcept>
 #include <charconv>
 #include <span>
 #include <optional>
 #include <unordered_map>
+#include <algorithm>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define CLOGPARSER_HAS_RDTSC
+#endif
 
 namespace events = clogparser::events;
 
@@ -15,31 +25,35 @@ namespace {
   constexpr std::string_view AURA_TYPE_BUFF = "BUFF";
   constexpr std::string_view AURA_TYPE_DEBUFF = "DEBUFF";
 
-  events::Unit convert(clogparser::String_store& store, events::Unit in) {
+  template<typename Store>
+  events::Unit convert(Store& store, events::Unit in) {
     return {
-      store.get(in.guid),
+      in.guid,
       store.get(in.name),
       in.flags,
       in.raid_flags
     };
   }
-  events::Combat_header convert(clogparser::String_store& store, events::Combat_header in) {
+  template<typename Store>
+  events::Combat_header convert(Store& store, events::Combat_header in) {
     return {
       convert(store, in.source),
       convert(store ,in.dest)
     };
   }
-  events::Spell_info convert(clogparser::String_store& store, events::Spell_info in) {
+  template<typename Store>
+  events::Spell_info convert(Store& store, events::Spell_info in) {
     return {
       in.id,
       store.get(in.name),
       in.school
     };
   }
-  events::Advanced_info convert(clogparser::String_store& store, events::Advanced_info in) {
+  template<typename Store>
+  events::Advanced_info convert(Store&, events::Advanced_info in) {
     return {
-      store.get(in.advanced_unit_guid),
-      store.get(in.owner_guid),
+      in.advanced_unit_guid,
+      in.owner_guid,
       in.current_hp,
       in.max_hp,
       in.attack_power,
@@ -57,138 +71,160 @@ namespace {
       in.level
     };
   }
-  events::Damage convert(clogparser::String_store&, events::Damage in) {
+  template<typename Store>
+  events::Damage convert(Store&, events::Damage in) {
     return in;
   }
-  events::Heal convert(clogparser::String_store&, events::Heal in) {
+  template<typename Store>
+  events::Heal convert(Store&, events::Heal in) {
     return in;
   }
 
-  std::vector<clogparser::Item> parse_items(std::string_view in) {
-    std::vector<clogparser::Item> returning;
-    const auto parsed_in = clogparser::helpers::parse_array(in);
-
-    std::vector<std::string_view> parsed_sub_in;
-
-    std::vector<std::string_view> temp;
-
-    for (auto const& sub_in : parsed_in) {
-      parsed_sub_in.clear();
-      clogparser::helpers::parse_array(parsed_sub_in, sub_in);
-
-      if (parsed_sub_in.size() != 5) {
-        throw std::exception("Item didn't have 5 fields");
-      }
-
-      returning.emplace_back();
-      returning.back().item_id = clogparser::helpers::parseInt<std::uint64_t>(parsed_sub_in[0]);
-      returning.back().ilvl = clogparser::helpers::parseInt<std::uint16_t>(parsed_sub_in[1]);
-
-      temp.clear();
-      clogparser::helpers::parse_array(temp, parsed_sub_in[2]);
-
-      if (temp.size() == 0 || (temp.size() == 1 && temp.front().empty())) {
-        //do nothing, they're all nullopt
-      } else if (temp.size() == 3) {
-        const auto e1 = clogparser::helpers::parseInt<std::uint64_t>(temp[0]);
-        if (e1 != 0) {
-          returning.back().permanent_enchant_id = e1;
-        }
-        const auto e2 = clogparser::helpers::parseInt<std::uint64_t>(temp[1]);
-        if (e2 != 0) {
-          returning.back().temp_enchant_id = e2;
-        }
-        const auto e3 = clogparser::helpers::parseInt<std::uint64_t>(temp[2]);
-        if (e3 != 0) {
-          returning.back().on_use_spell_enchant_id = e3;
-        }
-      } else {
-        throw std::exception("Item enchants didn't have 0 or 3 fields");
-      }
-
-      if (!parsed_sub_in[3].empty()) {
-        temp.clear();
-        clogparser::helpers::parse_array(temp, parsed_sub_in[3]);
-        for (auto const& bonus_id : temp) {
-          returning.back().bonus_ids.push_back(clogparser::helpers::parseInt<std::uint64_t>(bonus_id));
-        }
-      }
-
-      
-
-      if (!parsed_sub_in[4].empty()) {
-        temp.clear();
-        clogparser::helpers::parse_array(temp, parsed_sub_in[4]);
-        for (auto const& gem : temp) {
-          returning.back().gem_ids.push_back(clogparser::helpers::parseInt<std::uint64_t>(gem));
-        }
+  //in split into columns in arena, trying again with more room until they all fit
+  std::span<std::string_view> split_into(clogparser::Bump_arena& arena, std::string_view in, clogparser::Parse_error& error) {
+    for (std::size_t size = 16;; size *= 2) {
+      const auto returning = clogparser::helpers::parse_array(arena.allocate<std::string_view>(size), in, error);
+      if (returning.size() < size) {
+        return returning;
       }
     }
+  }
 
+  //the ids in in, which may be empty
+  std::span<const std::uint64_t> parse_ids(clogparser::Bump_arena& arena, std::string_view in, clogparser::Parse_error& error) {
+    if (in.empty()) {
+      return {};
+    }
+    const auto parsed_in = split_into(arena, in, error);
+    const auto returning = arena.allocate<std::uint64_t>(parsed_in.size());
+    for (std::size_t i = 0; i < parsed_in.size(); ++i) {
+      returning[i] = clogparser::helpers::parseInt<std::uint64_t>(parsed_in[i], error);
+    }
     return returning;
   }
 
-  clogparser::Aura_type parse_aura_type(std::string_view in) {
+  clogparser::Aura_type parse_aura_type(std::string_view in, clogparser::Parse_error& error) noexcept {
     if (in == AURA_TYPE_BUFF) {
       return clogparser::Aura_type::buff;
     } else {
-      assert(in == AURA_TYPE_DEBUFF);
+      if (in != AURA_TYPE_DEBUFF) {
+        error = clogparser::Parse_error::unexpected_value;
+      }
       return clogparser::Aura_type::debuff;
     }
   }
 
-  std::vector<clogparser::events::Combatant_info::Talent> parse_talents(std::string_view in) {
-    std::vector<clogparser::events::Combatant_info::Talent> returning;
+}
+std::span<const clogparser::Item> clogparser::internal::parse_items(Bump_arena& arena, std::string_view in, clogparser::Parse_error& error) {
+  const auto parsed_in = split_into(arena, in, error);
+  const auto returning = arena.allocate<clogparser::Item>(parsed_in.size());
+
+  //one more than the fields there should be, to tell if there are too many
+  std::array<std::string_view, 6> fields;
+  std::array<std::string_view, 4> enchants;
 
-    if (in.empty()) {
-      return returning;
+  for (std::size_t i = 0; i < parsed_in.size(); ++i) {
+    const auto parsed_sub_in = clogparser::helpers::parse_array(fields, parsed_in[i], error);
+
+    if (parsed_sub_in.size() != 5) { //item didn't have 5 fields
+      error = clogparser::Parse_error::unexpected_value;
+      return returning.first(i);
     }
 
-    std::vector<std::string_view> parsed_in = clogparser::helpers::parse_array(in);
-    std::vector<std::string_view> parsed_talent;
+    clogparser::Item& item = returning[i];
+    item.item_id = clogparser::helpers::parseInt<std::uint64_t>(parsed_sub_in[0], error);
+    item.ilvl = clogparser::helpers::parseInt<std::uint16_t>(parsed_sub_in[1], error);
 
-    for (auto const& sub_in : parsed_in) {
-      parsed_talent.clear();
-      clogparser::helpers::parse_array(parsed_talent, sub_in);
+    const auto temp = clogparser::helpers::parse_array(enchants, parsed_sub_in[2], error);
 
-      if (parsed_talent.size() != 3) {
-        throw std::exception("Talent didn't have 3 fields");
+    if (temp.size() == 0 || (temp.size() == 1 && temp.front().empty())) {
+      //do nothing, they're all nullopt
+    } else if (temp.size() == 3) {
+      const auto e1 = clogparser::helpers::parseInt<std::uint64_t>(temp[0], error);
+      if (e1 != 0) {
+        item.permanent_enchant_id = e1;
       }
+      const auto e2 = clogparser::helpers::parseInt<std::uint64_t>(temp[1], error);
+      if (e2 != 0) {
+        item.temp_enchant_id = e2;
+      }
+      const auto e3 = clogparser::helpers::parseInt<std::uint64_t>(temp[2], error);
+      if (e3 != 0) {
+        item.on_use_spell_enchant_id = e3;
+      }
+    } else { //item enchants didn't have 0 or 3 fields
+      error = clogparser::Parse_error::unexpected_value;
+      return returning.first(i + 1);
+    }
 
-      clogparser::events::Combatant_info::Talent adding{ 0 };
-      //parsed_talent[0] is unknown
-      adding.trait_node_entry_id = clogparser::helpers::parseInt<std::uint32_t>(parsed_talent[1]);
-      adding.rank = clogparser::helpers::parseInt<std::uint8_t>(parsed_talent[2]);
+    item.bonus_ids = parse_ids(arena, parsed_sub_in[3], error);
+    item.gem_ids = parse_ids(arena, parsed_sub_in[4], error);
+  }
 
-      returning.push_back(adding);
-    }
+  return returning;
+}
 
-    return returning;
+std::span<const events::Combatant_info::Talent> clogparser::internal::parse_talents(Bump_arena& arena, std::string_view in, clogparser::Parse_error& error) {
+  if (in.empty()) {
+    return {};
   }
 
-  std::vector<events::Combatant_info::Interesting_aura> parse_interesting_auras(std::string_view in) {
-    std::vector<events::Combatant_info::Interesting_aura> returning;
+  const auto parsed_in = split_into(arena, in, error);
+  const auto returning = arena.allocate<clogparser::events::Combatant_info::Talent>(parsed_in.size());
+  std::array<std::string_view, 4> fields;
 
-    const auto parsed_in = clogparser::helpers::parse_array(in);
+  for (std::size_t i = 0; i < parsed_in.size(); ++i) {
+    const auto parsed_talent = clogparser::helpers::parse_array(fields, parsed_in[i], error);
 
-    if ((parsed_in.size() % 2) != 0) {
-      return returning;
+    if (parsed_talent.size() != 3) { //talent didn't have 3 fields
+      error = clogparser::Parse_error::unexpected_value;
+      return returning.first(i);
     }
 
-    returning.reserve(parsed_in.size() / 2);
+    //parsed_talent[0] is unknown
+    returning[i].trait_node_entry_id = clogparser::helpers::parseInt<std::uint32_t>(parsed_talent[1], error);
+    returning[i].rank = clogparser::helpers::parseInt<std::uint8_t>(parsed_talent[2], error);
+  }
+
+  return returning;
+}
 
-    for (std::size_t i = 0; i < parsed_in.size(); i += 2) {
-      returning.push_back(
-        events::Combatant_info::Interesting_aura{
-          parsed_in[i],
-          clogparser::helpers::parseInt<std::uint64_t>(parsed_in[i + 1])
-        });
-    }
+std::span<const events::Combatant_info::Interesting_aura> clogparser::internal::parse_interesting_auras(Bump_arena& arena, std::string_view in, clogparser::Parse_error& error) {
+  const auto parsed_in = split_into(arena, in, error);
 
-    return returning;
+  if ((parsed_in.size() % 2) != 0) {
+    return {};
+  }
+
+  const auto returning = arena.allocate<events::Combatant_info::Interesting_aura>(parsed_in.size() / 2);
+
+  for (std::size_t i = 0; i < returning.size(); ++i) {
+    returning[i] = events::Combatant_info::Interesting_aura{
+      clogparser::helpers::parse_guid(parsed_in[2 * i], error),
+      clogparser::helpers::parseInt<std::uint64_t>(parsed_in[2 * i + 1], error)
+    };
+  }
+
+  return returning;
+}
+
+std::span<const std::string_view> clogparser::internal::parse_pvp_talents(Bump_arena& arena, std::string_view in, Parse_error& error) {
+  return split_into(arena, in, error);
+}
+
+clogparser::Stats clogparser::internal::parse_stats(helpers::Columns_span columns, Parse_error& error) noexcept {
+  Stats returning;
+  for (std::size_t i = 0; i < Stats::size; ++i) {
+    returning[static_cast<Attribute_rating>(i)] = helpers::parseInt<std::int32_t>(columns[i], error);
   }
+  return returning;
 }
+
 std::chrono::milliseconds clogparser::Timestamp::operator-(Timestamp const& other) const noexcept {
+  if (year != 0 && other.year != 0) {
+    return since_epoch() - other.since_epoch();
+  }
+
   const std::chrono::milliseconds us_duration = std::chrono::hours{ hour }
     + std::chrono::minutes{ minute }
     + std::chrono::seconds{ second }
@@ -206,229 +242,298 @@ std::chrono::milliseconds clogparser::Timestamp::operator-(Timestamp const& othe
   }
 }
 
-std::size_t clogparser::internal::String_hash::operator()(std::string const& str) const noexcept {
-  std::hash<std::string_view> hasher;
-  return hasher(str);
-}
-std::size_t clogparser::internal::String_hash::operator()(std::string_view str) const noexcept {
-  std::hash<std::string_view> hasher;
-  return hasher(str);
+clogparser::Period clogparser::Timestamp::since_epoch() const noexcept {
+  const std::chrono::sys_days date{ std::chrono::year{ year } / std::chrono::month{ month } / std::chrono::day{ day } };
+  return date.time_since_epoch()
+    + std::chrono::hours{ hour }
+    + std::chrono::minutes{ minute }
+    + std::chrono::seconds{ second }
+    + std::chrono::milliseconds{ millisecond };
 }
 
-clogparser::helpers::Columns_span clogparser::helpers::parse_array(Columns_span returning, std::string_view in) {
-
+clogparser::Timestamp clogparser::Timestamp::from_epoch(Period since_epoch) noexcept {
+  const std::chrono::sys_days days = std::chrono::floor<std::chrono::days>(std::chrono::sys_time<Period>{ since_epoch });
+  const std::chrono::year_month_day date{ days };
+  const std::chrono::hh_mm_ss<Period> time{ since_epoch - days.time_since_epoch() };
+  return Timestamp{
+    static_cast<std::uint8_t>(static_cast<unsigned>(date.month())),
+    static_cast<std::uint8_t>(static_cast<unsigned>(date.day())),
+    static_cast<std::uint8_t>(time.hours().count()),
+    static_cast<std::uint8_t>(time.minutes().count()),
+    static_cast<std::uint8_t>(time.seconds().count()),
+    static_cast<std::uint16_t>(time.subseconds().count()),
+    static_cast<std::uint16_t>(static_cast<int>(date.year()))
+  };
+}
 
-  std::string_view::size_type found = 0;
-  bool quoted = false;
+std::string_view clogparser::Parse_stats::type_name(std::size_t index) noexcept {
+  return internal::Type_table<events::Type>::NAMES[index];
+}
 
-  std::size_t on = 0;
+std::uint64_t clogparser::internal::cycles() noexcept {
+#ifdef CLOGPARSER_HAS_RDTSC
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
 
-  while (in.size() > 0) {
-    if (in[0] == '"') {
-      const auto found = in.find("\",");
-      if (found == in.npos) {
+namespace {
+  //the digits of in up to end, which is consumed. end of 0 means the end of in
+  bool read_field(std::string_view& in, char end, unsigned& returning) noexcept {
+    unsigned value = 0;
+    std::size_t on = 0;
+    for (; on < in.size() && on < 4; ++on) {
+      const unsigned digit = static_cast<unsigned char>(in[on]) - static_cast<unsigned>('0');
+      if (digit > 9) {
         break;
       }
-      returning[on] = in.substr(1, found - 1);
-      ++on;
-      if (on == returning.size()) {
-        return returning;
-      }
-      in = in.substr(found + 2);
-    } else if (in[0] == '[' || in[0] == '(') {
-      bool found = false;
-      bool in_quote = false;
-      int bracket_open_count = 1;
-      for (std::string_view::size_type i = 1; i < in.size(); ++i) {
-        if (!in_quote && (in[i] == '[' || in[i] == '(')) {
-          bracket_open_count++;
-        } else if (!in_quote && (in[i] == ']' || in[i] == ')')) {
-          bracket_open_count--;
-        } else if (in[i] == '"') {
-          in_quote = !in_quote;
-        } else if (in[i] == ',' && !in_quote && bracket_open_count == 0) {
-          returning[on] = in.substr(1, i - 2);
-          ++on;
-          if (on == returning.size()) {
-            return returning;
-          }
-          in = in.substr(i + 1);
-          found = true;
-          break;
-        }
-      }
-      if (!found) {
-        break;
+      value = value * 10 + digit;
+    }
+    if (on == 0) {
+      return false;
+    }
+    if (end == 0) {
+      if (on != in.size()) {
+        return false;
       }
+      in = {};
     } else {
-      const auto found = in.find(',');
-      if (found == in.npos) {
-        break;
-      }
-      returning[on] = in.substr(0, found);
-      ++on;
-      if (on == returning.size()) {
-        return returning;
+      if (on == in.size() || in[on] != end) {
+        return false;
       }
-      in = in.substr(found + 1);
+      in = in.substr(on + 1);
     }
+    returning = value;
+    return true;
   }
-  if (in.size() > 0 && in[0] == '"') {
-    if (in.size() > 1 && in.back() == '"') {
-      returning[on] = in.substr(1, in.size() - 2);
-      ++on;
-    } else {
-      throw std::exception("Couldn't find quote termiantor");
-    }
-  } else if (in.size() > 0 && in[0] == '[') {
-    if (in.size() > 1 && in.back() == ']') {
-      returning[on] = in.substr(1, in.size() - 2);
-      ++on;
-    } else {
-      throw std::exception("Couldn't find array terminator");
-    }
-  } else if (in.size() > 0 && in[0] == '(') {
-    if (in.size() > 1 && in.back() == ')') {
-      returning[on] = in.substr(1, in.size() - 2);
-      ++on;
-    } else {
-      throw std::exception("Couldn't find tuple terminator");
+}
+
+std::optional<std::chrono::year_month_day> clogparser::log_file_date(std::string_view file_name) noexcept {
+  constexpr std::string_view PREFIX = "WoWCombatLog-";
+  const auto found = file_name.rfind(PREFIX);
+  if (found == std::string_view::npos) {
+    return std::nullopt;
+  }
+  std::string_view date = file_name.substr(found + PREFIX.size());
+  if (date.size() < 7 || date[6] != '_') {
+    return std::nullopt;
+  }
+
+  unsigned fields[3];
+  for (unsigned& field : fields) {
+    std::string_view digits = date.substr(0, 2);
+    if (!read_field(digits, 0, field)) {
+      return std::nullopt;
     }
-  } else {
-    returning[on] = in;
-    ++on;
+    date = date.substr(2);
   }
 
-  return returning.subspan(0, on);
+  const std::chrono::year_month_day returning{
+    std::chrono::year{ 2000 + static_cast<int>(fields[2]) },
+    std::chrono::month{ fields[0] },
+    std::chrono::day{ fields[1] } };
+  if (!returning.ok()) {
+    return std::nullopt;
+  }
+  return returning;
 }
 
-void clogparser::helpers::parse_array(std::vector<std::string_view>& returning, std::string_view in) {
-  std::string_view::size_type found = 0;
-  bool quoted = false;
+clogparser::Timestamp_decoder::Timestamp_decoder(std::chrono::year_month_day log_start) noexcept :
+  year_(static_cast<std::uint16_t>(static_cast<int>(log_start.year()))),
+  month_(static_cast<std::uint8_t>(static_cast<unsigned>(log_start.month()))) {
 
-  while (in.size() > 0) {
-    if (in[0] == '"') {
-      const auto found = in.find("\",");
-      if (found == in.npos) {
-        break;
-      }
-      returning.push_back(in.substr(1, found - 1));
-      in = in.substr(found + 2);
-    } else if (in[0] == '[' || in[0] == '(') {
-      bool found = false;
-      bool in_quote = false;
-      int bracket_open_count = 1;
-      for (std::string_view::size_type i = 1; i < in.size(); ++i) {
-        if (!in_quote && (in[i] == '[' || in[i] == '(')) {
-          bracket_open_count++;
-        } else if (!in_quote && (in[i] == ']' || in[i] == ')')) {
-          bracket_open_count--;
-        } else if (in[i] == '"') {
-          in_quote = !in_quote;
-        } else if (in[i] == ',' && !in_quote && bracket_open_count == 0) {
-          returning.push_back(in.substr(1, i - 2));
-          in = in.substr(i + 1);
-          found = true;
-          break;
-        }
-      }
-      if (!found) {
-        break;
-      }
-    } else {
-      const auto found = in.find(',');
-      if (found == in.npos) {
-        break;
-      }
-      returning.push_back(in.substr(0, found));
-      in = in.substr(found + 1);
-    }
+}
+
+clogparser::Timestamp_decoder clogparser::Timestamp_decoder::starting_at(Timestamp time) noexcept {
+  if (time.year == 0) {
+    return {};
   }
-  if (in.size() > 0 && in[0] == '"') {
-    if (in.size() > 1 && in.back() == '"') {
-      returning.push_back(in.substr(1, in.size() - 2));
-    } else {
-      throw std::exception("Couldn't find quote termiantor");
+  return Timestamp_decoder{ std::chrono::year{ time.year } / std::chrono::month{ time.month } / std::chrono::day{ time.day } };
+}
+
+std::optional<clogparser::Timestamp> clogparser::Timestamp_decoder::decode(std::string_view in, Parse_error& error) noexcept {
+  const auto found_second = in.find('.');
+  if (found_second == std::string_view::npos) {
+    error = Parse_error::bad_timestamp;
+    return std::nullopt;
+  }
+
+  const std::string_view prefix = in.substr(0, found_second);
+  if (prefix_size_ == 0 || prefix != std::string_view{ prefix_.data(), prefix_size_ }) {
+    if (!decode_prefix_(prefix)) {
+      prefix_size_ = 0;
+      error = Parse_error::bad_timestamp;
+      return std::nullopt;
     }
-  } else if (in.size() > 0 && in[0] == '[') {
-    if (in.size() > 1 && in.back() == ']') {
-      returning.push_back(in.substr(1, in.size() - 2));
-    } else {
-      throw std::exception("Couldn't find array terminator");
+  }
+
+  //the fraction of a second, to the millisecond. newer logs add a digit and a timezone
+  std::uint16_t millisecond = 0;
+  std::size_t digits = 0;
+  for (char c : in.substr(found_second + 1)) {
+    const unsigned digit = static_cast<unsigned char>(c) - static_cast<unsigned>('0');
+    if (digit > 9) {
+      break;
     }
-  } else if (in.size() > 0 && in[0] == '(') {
-    if (in.size() > 1 && in.back() == ')') {
-      returning.push_back(in.substr(1, in.size() - 2));
-    } else {
-      throw std::exception("Couldn't find tuple terminator");
+    if (digits < 3) {
+      millisecond = static_cast<std::uint16_t>(millisecond * 10 + digit);
     }
-  } else {
-    returning.push_back(in);
+    ++digits;
   }
-}
-std::vector<std::string_view> clogparser::helpers::parse_array(std::string_view in) {
-  std::vector<std::string_view> returning;
-  parse_array(returning, in);
+  if (digits == 0) {
+    error = Parse_error::bad_timestamp;
+    return std::nullopt;
+  }
+  for (; digits < 3; ++digits) {
+    millisecond *= 10;
+  }
+
+  Timestamp returning = last_;
+  returning.millisecond = millisecond;
   return returning;
 }
 
-std::optional<clogparser::Timestamp> clogparser::internal::parse_timestamp(std::string_view time) {
-  try {
-    clogparser::Timestamp returning{ 0 };
+bool clogparser::Timestamp_decoder::decode_prefix_(std::string_view prefix) noexcept {
+  std::string_view in = prefix;
+  unsigned month = 0;
+  unsigned day = 0;
+  unsigned year = 0;
+  unsigned hour = 0;
+  unsigned minute = 0;
+  unsigned second = 0;
 
-    const auto found_month = time.find('/');
-    if (found_month == time.npos) {
-      fprintf(stderr, "Timestamp is missing a month: %.*s\n", (std::uint32_t)time.size(), time.data());
-      return std::nullopt;
-    }
-    returning.month = clogparser::helpers::parseInt<std::uint8_t>(time.substr(0, found_month));
-    time = time.substr(found_month + 1);
+  if (!read_field(in, '/', month)) {
+    return false;
+  }
+  const auto found_day = in.find_first_of(" /");
+  if (found_day == std::string_view::npos) {
+    return false;
+  }
+  const bool has_year = in[found_day] == '/';
+  if (!read_field(in, in[found_day], day)
+    || (has_year && !read_field(in, ' ', year))
+    || !read_field(in, ':', hour)
+    || !read_field(in, ':', minute)
+    || !read_field(in, 0, second)) {
+    return false;
+  }
+  if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+    return false;
+  }
 
-    const auto found_day = time.find(' ');
-    if (found_day == time.npos) {
-      fprintf(stderr, "Timestamp is missing a day: %.*s\n", (std::uint32_t)time.size(), time.data());
-      return std::nullopt;
-    }
-    returning.day = clogparser::helpers::parseInt<std::uint8_t>(time.substr(0, found_day));
-    time = time.substr(found_day + 1);
+  if (has_year) {
+    year_ = static_cast<std::uint16_t>(year);
+  } else if (year_ != 0 && month < month_) { //went past new year
+    ++year_;
+  }
+  month_ = static_cast<std::uint8_t>(month);
+
+  last_ = Timestamp{
+    static_cast<std::uint8_t>(month),
+    static_cast<std::uint8_t>(day),
+    static_cast<std::uint8_t>(hour),
+    static_cast<std::uint8_t>(minute),
+    static_cast<std::uint8_t>(second),
+    0,
+    year_
+  };
 
-    const auto found_hour = time.find(':');
-    if (found_hour == time.npos) {
-      fprintf(stderr, "Timestamp is missing an hour: %.*s\n", (std::uint32_t)time.size(), time.data());
-      return std::nullopt;
-    }
-    returning.hour = clogparser::helpers::parseInt<std::uint8_t>(time.substr(0, found_hour));
-    time = time.substr(found_hour + 1);
+  if (prefix.size() <= prefix_.size()) {
+    std::copy(prefix.begin(), prefix.end(), prefix_.begin());
+    prefix_size_ = prefix.size();
+  } else {
+    prefix_size_ = 0;
+  }
+  return true;
+}
+
+std::string_view clogparser::to_string(Parse_error error) noexcept {
+  switch (error) {
+  case Parse_error::none:
+    return "none";
+  case Parse_error::missing_timestamp:
+    return "couldn't find timestamp";
+  case Parse_error::missing_type:
+    return "couldn't find type";
+  case Parse_error::bad_timestamp:
+    return "couldn't parse timestamp";
+  case Parse_error::bad_number:
+    return "couldn't parse number";
+  case Parse_error::not_enough_columns:
+    return "not enough columns";
+  case Parse_error::unterminated_quote:
+    return "couldn't find quote terminator";
+  case Parse_error::unterminated_array:
+    return "couldn't find array terminator";
+  case Parse_error::unterminated_tuple:
+    return "couldn't find tuple terminator";
+  case Parse_error::unexpected_value:
+    return "unexpected value";
+  }
+  return "unknown";
+}
 
-    const auto found_minute = time.find(':');
-    if (found_minute == time.npos) {
-      fprintf(stderr, "Timestamp is missing a minute: %.*s\n", (std::uint32_t)time.size(), time.data());
-      return std::nullopt;
+namespace {
+  clogparser::Parse_error unterminated(char opener) noexcept {
+    switch (opener) {
+    case '"':
+      return clogparser::Parse_error::unterminated_quote;
+    case '[':
+      return clogparser::Parse_error::unterminated_array;
+    default:
+      return clogparser::Parse_error::unterminated_tuple;
     }
-    returning.minute = clogparser::helpers::parseInt<std::uint8_t>(time.substr(0, found_minute));
-    time = time.substr(found_minute + 1);
+  }
+}
 
-    const auto found_second = time.find('.');
-    if (found_second == time.npos) {
-      fprintf(stderr, "Timestamp is missing a second: %.*s\n", (std::uint32_t)time.size(), time.data());
-      return std::nullopt;
+clogparser::helpers::Columns_span clogparser::helpers::parse_array(Columns_span returning, std::string_view in, Parse_error& error) noexcept {
+  const auto split = split_columns(in, returning);
+  if (split.unterminated != 0) {
+    error = unterminated(split.unterminated);
+  }
+  return returning.subspan(0, split.count);
+}
+
+void clogparser::helpers::parse_array(std::vector<std::string_view>& returning, std::string_view in, Parse_error& error) {
+  //split into the spare capacity, growing it until the whole of in fits
+  std::size_t on = returning.size();
+  returning.resize(on + 16);
+  for (;;) {
+    const auto split = split_columns(in, Columns_span{ returning }.subspan(on));
+    on += split.count;
+    if (split.unterminated != 0) {
+      error = unterminated(split.unterminated);
+      break;
+    }
+    if (split.rest == std::string_view::npos) {
+      break;
     }
-    returning.second = clogparser::helpers::parseInt<std::uint8_t>(time.substr(0, found_second));
-    time = time.substr(found_second + 1);
+    in = in.substr(split.rest);
+    returning.resize(returning.size() * 2);
+  }
+  returning.resize(on);
+}
+std::vector<std::string_view> clogparser::helpers::parse_array(std::string_view in, Parse_error& error) {
+  std::vector<std::string_view> returning;
+  parse_array(returning, in, error);
+  return returning;
+}
 
-    returning.millisecond = clogparser::helpers::parseInt<std::uint16_t>(time);
+std::optional<clogparser::Timestamp> clogparser::internal::parse_timestamp(std::string_view time, Parse_error& error) noexcept {
+  Timestamp_decoder decoder;
+  return decoder.decode(time, error);
+}
 
-    return returning;
-  } catch (std::exception const& ex) {
-    fprintf(stderr, "Couldn't parse timestamp due to exception: %s\n", ex.what());
+std::optional<clogparser::internal::Partial_parse> clogparser::internal::parse_line(helpers::Parser&, std::string_view in, Parse_error& error) noexcept {
+  if (in.empty()) { //nothing to report for a blank line
     return std::nullopt;
   }
-}
 
-std::optional<clogparser::internal::Partial_parse> clogparser::internal::parse_line(helpers::Parser& parser, std::string_view in) {
   const auto end_timestamp = in.find("  ");
   if (end_timestamp == std::string_view::npos) {
-    fprintf(stdout, "Couldn't find timestamp in line: %.*s\n", (std::uint32_t)in.size(), in.data());
+    error = Parse_error::missing_timestamp;
     return std::nullopt;
   }
   const std::string_view timestamp_str = in.substr(0, end_timestamp);
@@ -436,7 +541,7 @@ std::optional<clogparser::internal::Partial_parse> clogparser::internal::parse_l
 
   const auto end_type = in.find(',');
   if (end_type == std::string_view::npos) {
-    fprintf(stdout, "Couldn't find type in line: %.*s\n", (std::uint32_t)in.size(), in.data());
+    error = Parse_error::missing_type;
     return std::nullopt;
   }
   const std::string_view type_str = in.substr(0, end_type);
@@ -445,789 +550,982 @@ std::optional<clogparser::internal::Partial_parse> clogparser::internal::parse_l
   return Partial_parse{ timestamp_str, type_str, in};
 }
 
-void clogparser::helpers::parseInt(bool& returning, std::string_view in) {
+void clogparser::helpers::parseInt(bool& returning, std::string_view in, Parse_error& error) noexcept {
   if (in == "nil") {
     returning = false;
   } else {
     std::uint32_t checking = 0;
-    parseInt(checking, in);
+    parseInt(checking, in, error);
     returning = (checking != 0);
   }
 }
 
-events::Unit clogparser::internal::Parse<events::Unit>::parse(helpers::Columns_span columns) {
+template<>
+events::Unit clogparser::internal::Parse<events::Unit>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Unit::COLUMNS_COUNT) {
-    throw std::exception("Not enough columns for a unit");
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return events::Unit{
-    columns[0],
+    helpers::parse_guid(columns[0], error),
     columns[1],
-    Unit_flags(helpers::parseInt<Unit_flags::Underlying>(columns[2])),
-    Raid_flags(helpers::parseInt<Raid_flags::Underlying_type>(columns[3]))
+    Unit_flags(helpers::parseInt<Unit_flags::Underlying>(columns[2], error)),
+    Raid_flags(helpers::parseInt<Raid_flags::Underlying_type>(columns[3], error))
   };
 }
-events::Combat_header clogparser::internal::Parse<events::Combat_header>::parse(helpers::Columns_span columns) {
+template<>
+events::Combat_header clogparser::internal::Parse<events::Combat_header>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size()<events::Combat_header::COLUMNS_COUNT) {
-    throw std::exception("Not enough columns for a combat header");
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return events::Combat_header{
-    Parse<events::Unit>::parse(columns.subspan(0, 4)),
-    Parse<events::Unit>::parse(columns.subspan(4, 4))
+    Parse<events::Unit>::parse(columns.subspan(0, 4), error),
+    Parse<events::Unit>::parse(columns.subspan(4, 4), error)
   };
 }
-events::Spell_info clogparser::internal::Parse<events::Spell_info>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_info clogparser::internal::Parse<events::Spell_info>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Spell_info::COLUMNS_COUNT) {
-    throw std::exception("Not enough columns for a spell info");
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return events::Spell_info{
-    helpers::parseInt<std::uint64_t>(columns[0]),
+    helpers::parseInt<std::uint64_t>(columns[0], error),
     columns[1],
-    Spell_schools(helpers::parseInt<Spell_schools::Underlying_type>(columns[2]))
+    Spell_schools(helpers::parseInt<Spell_schools::Underlying_type>(columns[2], error))
   };
 }
-events::Advanced_info clogparser::internal::Parse<events::Advanced_info>::parse(helpers::Columns_span columns) {
+template<>
+events::Advanced_info clogparser::internal::Parse<events::Advanced_info>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Advanced_info::COLUMNS_COUNT) {
-    throw std::exception("Not enough columns for advanced info");
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return events::Advanced_info{
-    columns[0],
-    columns[1],
-    helpers::parseInt<std::uint64_t>(columns[2]),
-    helpers::parseInt<std::uint64_t>(columns[3]),
-    helpers::parseInt<std::int64_t>(columns[4]),
-    helpers::parseInt<std::int64_t>(columns[5]),
-    helpers::parseInt<std::int64_t>(columns[6]),
-    helpers::parseInt<std::int64_t>(columns[7]),
-    Power_types::alternate_power, //NYI, need to handle multiple values
-    0, //NYI, need to handle multiple values
-    0, //NYI, need to handle multiple values
-    0, //NYI, need to handle multiple values
-    helpers::parseInt<float>(columns[12]),
-    helpers::parseInt<float>(columns[13]),
-    helpers::parseInt<std::uint64_t>(columns[14]),
-    helpers::parseInt<float>(columns[15]),
-    helpers::parseInt<std::uint16_t>(columns[16])
+    helpers::parse_guid(columns[0], error),
+    helpers::parse_guid(columns[1], error),
+    helpers::parseInt<std::uint64_t>(columns[2], error),
+    helpers::parseInt<std::uint64_t>(columns[3], error),
+    helpers::parseInt<std::int64_t>(columns[4], error),
+    helpers::parseInt<std::int64_t>(columns[5], error),
+    helpers::parseInt<std::int64_t>(columns[6], error),
+    helpers::parseInt<std::int64_t>(columns[7], error),
+    static_cast<Power_types>(helpers::parseInt<int>(helpers::first_power(columns[8]), error)),
+    helpers::parseInt<std::uint64_t>(helpers::first_power(columns[9]), error),
+    helpers::parseInt<std::uint64_t>(helpers::first_power(columns[10]), error),
+    helpers::parseInt<std::uint64_t>(helpers::first_power(columns[11]), error),
+    helpers::parseInt<float>(columns[12], error),
+    helpers::parseInt<float>(columns[13], error),
+    helpers::parseInt<std::uint64_t>(columns[14], error),
+    helpers::parseInt<float>(columns[15], error),
+    helpers::parseInt<std::uint16_t>(columns[16], error)
   };
 }
-events::Damage clogparser::internal::Parse<events::Damage>::parse(helpers::Columns_span columns) {
+template<>
+events::Damage clogparser::internal::Parse<events::Damage>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Damage::COLUMNS_COUNT) {
-    throw std::exception{"not enough columns for damage"};
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return events::Damage{
-    helpers::parseInt<std::int64_t>(columns[0]),
-    helpers::parseInt<std::int64_t>(columns[1]),
-    helpers::parseInt<std::int64_t>(columns[2]),
-    Spell_schools(helpers::parseInt<Spell_schools::Underlying_type>(columns[3])),
-    helpers::parseInt<std::int64_t>(columns[4]),
-    helpers::parseInt<std::uint64_t>(columns[5]),
-    helpers::parseInt<std::int32_t>(columns[6]),
-    helpers::parseInt<bool>(columns[7]),
-    helpers::parseInt<bool>(columns[8]),
-    helpers::parseInt<bool>(columns[9])
+    helpers::parseInt<std::int64_t>(columns[0], error),
+    helpers::parseInt<std::int64_t>(columns[1], error),
+    helpers::parseInt<std::int64_t>(columns[2], error),
+    Spell_schools(helpers::parseInt<Spell_schools::Underlying_type>(columns[3], error)),
+    helpers::parseInt<std::int64_t>(columns[4], error),
+    helpers::parseInt<std::uint64_t>(columns[5], error),
+    helpers::parseInt<std::int32_t>(columns[6], error),
+    helpers::parseInt<bool>(columns[7], error),
+    helpers::parseInt<bool>(columns[8], error),
+    helpers::parseInt<bool>(columns[9], error)
   };
 }
-events::Heal clogparser::internal::Parse<events::Heal>::parse(helpers::Columns_span columns) {
+template<>
+events::Heal clogparser::internal::Parse<events::Heal>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Heal::COLUMNS_COUNT) {
-    throw std::exception{"Not enough columns for healing"};
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return events::Heal{
-    helpers::parseInt<std::uint64_t>(columns[0]),
-    helpers::parseInt<std::uint64_t>(columns[1]),
-    helpers::parseInt<std::uint64_t>(columns[2]),
-    helpers::parseInt<std::uint64_t>(columns[3]),
-    helpers::parseInt<bool>(columns[4])
+    helpers::parseInt<std::uint64_t>(columns[0], error),
+    helpers::parseInt<std::uint64_t>(columns[1], error),
+    helpers::parseInt<std::uint64_t>(columns[2], error),
+    helpers::parseInt<std::uint64_t>(columns[3], error),
+    helpers::parseInt<bool>(columns[4], error)
   };
 }
-events::Combat_log_version clogparser::internal::Parse<events::Combat_log_version>::parse(helpers::Columns_span columns) {
+template<>
+events::Combat_log_version clogparser::internal::Parse<events::Combat_log_version>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Combat_log_version::COLUMNS_COUNT) {
-    throw std::exception{"Not enough columns for a combat log version"};
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   if (columns[1] != "ADVANCED_LOG_ENABLED"
     || columns[3] != "BUILD_VERSION"
     || columns[5] != "PROJECT_ID") {
-    throw std::exception{"Unexpected variable names in combat log version"};
+    error = Parse_error::unexpected_value;
+    return {};
   }
 
   auto version = columns[4];
   const auto found_expac = version.find('.');
   if (found_expac == std::string_view::npos) {
-    throw std::exception("Couldn't find delimiter between expac and patch in combat log version");
+    error = Parse_error::unexpected_value; //no delimiter between expac and patch
+    return {};
   }
-  const auto expac = helpers::parseInt<std::uint8_t>(version.substr(0, found_expac));
+  const auto expac = helpers::parseInt<std::uint8_t>(version.substr(0, found_expac), error);
   version = version.substr(found_expac + 1);
   const auto found_major = version.find('.');
   if (found_major == std::string_view::npos) {
-    throw std::exception("Couldn't find delimiter between patch and minor in combat log version");
+    error = Parse_error::unexpected_value; //no delimiter between patch and minor
+    return {};
   }
-  const auto patch = helpers::parseInt<std::uint8_t>(version.substr(0, found_major));
-  const auto minor = helpers::parseInt<std::uint8_t>(version.substr(found_major + 1));
+  const auto patch = helpers::parseInt<std::uint8_t>(version.substr(0, found_major), error);
+  const auto minor = helpers::parseInt<std::uint8_t>(version.substr(found_major + 1), error);
 
   return {
-    helpers::parseInt<std::uint8_t>(columns[0]),
-    helpers::parseInt<bool>(columns[2]),
+    helpers::parseInt<std::uint8_t>(columns[0], error),
+    helpers::parseInt<bool>(columns[2], error),
     {
       expac,
       patch,
       minor,
     },
-    helpers::parseInt<std::uint8_t>(columns[6])
+    helpers::parseInt<std::uint8_t>(columns[6], error)
   };
 }
-events::Spell_aura_applied clogparser::internal::Parse<events::Spell_aura_applied>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_aura_applied clogparser::internal::Parse<events::Spell_aura_applied>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() == 12) {
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0,8)),
-      Parse<events::Spell_info>::parse(columns.subspan(8,3)),
-      parse_aura_type(columns[11]),
+      Parse<events::Combat_header>::parse(columns.subspan(0,8), error),
+      Parse<events::Spell_info>::parse(columns.subspan(8,3), error),
+      parse_aura_type(columns[11], error),
       std::nullopt
     };
   } else if (columns.size() > 12) {
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0,8)),
-      Parse<events::Spell_info>::parse(columns.subspan(8,3)),
-      parse_aura_type(columns[11]),
-      helpers::parseInt<std::uint64_t>(columns[12])
+      Parse<events::Combat_header>::parse(columns.subspan(0,8), error),
+      Parse<events::Spell_info>::parse(columns.subspan(8,3), error),
+      parse_aura_type(columns[11], error),
+      helpers::parseInt<std::uint64_t>(columns[12], error)
     };
   } else {
-    throw std::exception{"Not enough columns for spell aura applied"};
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 }
-events::Spell_aura_applied_dose clogparser::internal::Parse<events::Spell_aura_applied_dose>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_aura_applied_dose clogparser::internal::Parse<events::Spell_aura_applied_dose>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() != events::Spell_aura_applied_dose::COLUMNS_COUNT) {
-    throw std::exception{ "Not enough columns for a spell aura applied dose" };
+    error = Parse_error::not_enough_columns;
+    return {};
   }
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0,8)),
-    Parse<events::Spell_info>::parse(columns.subspan(8,3)),
-    parse_aura_type(columns[11]),
-    helpers::parseInt<std::uint8_t>(columns[12])
+    Parse<events::Combat_header>::parse(columns.subspan(0,8), error),
+    Parse<events::Spell_info>::parse(columns.subspan(8,3), error),
+    parse_aura_type(columns[11], error),
+    helpers::parseInt<std::uint8_t>(columns[12], error)
   };
 }
-events::Spell_aura_refresh clogparser::internal::Parse<events::Spell_aura_refresh>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_aura_refresh clogparser::internal::Parse<events::Spell_aura_refresh>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() == 12) {
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0,8)),
-      Parse<events::Spell_info>::parse(columns.subspan(8,3)),
-      parse_aura_type(columns[11]),
+      Parse<events::Combat_header>::parse(columns.subspan(0,8), error),
+      Parse<events::Spell_info>::parse(columns.subspan(8,3), error),
+      parse_aura_type(columns[11], error),
       std::nullopt
     };
   } else if (columns.size() > 12) {
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0,8)),
-      Parse<events::Spell_info>::parse(columns.subspan(8,3)),
-      parse_aura_type(columns[11]),
-      helpers::parseInt<std::uint64_t>(columns[12])
+      Parse<events::Combat_header>::parse(columns.subspan(0,8), error),
+      Parse<events::Spell_info>::parse(columns.subspan(8,3), error),
+      parse_aura_type(columns[11], error),
+      helpers::parseInt<std::uint64_t>(columns[12], error)
     };
   } else {
-    throw std::exception{"Not enough columns for spell aura applied"};
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 }
-events::Spell_aura_removed clogparser::internal::Parse<events::Spell_aura_removed>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_aura_removed clogparser::internal::Parse<events::Spell_aura_removed>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() == 12) {
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0,8)),
-      Parse<events::Spell_info>::parse(columns.subspan(8,3)),
+      Parse<events::Combat_header>::parse(columns.subspan(0,8), error),
+      Parse<events::Spell_info>::parse(columns.subspan(8,3), error),
       columns[11],
       std::nullopt
     };
   } else if (columns.size() > 12) {
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0,8)),
-      Parse<events::Spell_info>::parse(columns.subspan(8,3)),
+      Parse<events::Combat_header>::parse(columns.subspan(0,8), error),
+      Parse<events::Spell_info>::parse(columns.subspan(8,3), error),
       columns[11],
-      helpers::parseInt<std::uint64_t>(columns[12])
+      helpers::parseInt<std::uint64_t>(columns[12], error)
     };
   } else {
-    throw std::exception{"Not enough columns for spell aura applied"};
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 }
-events::Spell_aura_removed_dose clogparser::internal::Parse<events::Spell_aura_removed_dose>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_aura_removed_dose clogparser::internal::Parse<events::Spell_aura_removed_dose>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() != events::Spell_aura_applied_dose::COLUMNS_COUNT) {
-    throw std::exception{ "Not enough columns for a spell aura removed dose" };
+    error = Parse_error::not_enough_columns;
+    return {};
   }
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0,8)),
-    Parse<events::Spell_info>::parse(columns.subspan(8,3)),
-    parse_aura_type(columns[11]),
-    helpers::parseInt<std::uint8_t>(columns[12])
+    Parse<events::Combat_header>::parse(columns.subspan(0,8), error),
+    Parse<events::Spell_info>::parse(columns.subspan(8,3), error),
+    parse_aura_type(columns[11], error),
+    helpers::parseInt<std::uint8_t>(columns[12], error)
   };
 }
-events::Spell_periodic_damage clogparser::internal::Parse<events::Spell_periodic_damage>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_periodic_damage clogparser::internal::Parse<events::Spell_periodic_damage>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Spell_periodic_damage::COLUMNS_COUNT) {
-    throw std::exception{"Not enough columns for a spell periodic damage"};
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0,8)),
-    Parse<events::Spell_info>::parse(columns.subspan(8,3)),
-    Parse<events::Advanced_info>::parse(columns.subspan(11, 17)),
-    Parse<events::Damage>::parse(columns.subspan(28, 10))
+    Parse<events::Combat_header>::parse(columns.subspan(0,8), error),
+    Parse<events::Spell_info>::parse(columns.subspan(8,3), error),
+    Parse<events::Advanced_info>::parse(columns.subspan(11, 17), error),
+    Parse<events::Damage>::parse(columns.subspan(28, 10), error)
   };
 }
-events::Spell_periodic_damage_support clogparser::internal::Parse<events::Spell_periodic_damage_support>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_periodic_damage_support clogparser::internal::Parse<events::Spell_periodic_damage_support>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Spell_periodic_damage_support::COLUMNS_COUNT) {
-    throw std::exception{ "Not enough columns for a spell periodic damage support" };
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0, 8)),
-    Parse<events::Spell_info>::parse(columns.subspan(8,3)),
-    Parse<events::Advanced_info>::parse(columns.subspan(11,17)),
-    Parse<events::Damage>::parse(columns.subspan(28,10)),
+    Parse<events::Combat_header>::parse(columns.subspan(0, 8), error),
+    Parse<events::Spell_info>::parse(columns.subspan(8,3), error),
+    Parse<events::Advanced_info>::parse(columns.subspan(11,17), error),
+    Parse<events::Damage>::parse(columns.subspan(28,10), error),
     columns[38]
   };
 }
-events::Spell_periodic_missed clogparser::internal::Parse<events::Spell_periodic_missed>::parse(helpers::Columns_span columns) {
-  if (columns.size() < 12) {
-    throw std::exception("Not enough columns for spell missed");
+template<>
+events::Spell_periodic_missed clogparser::internal::Parse<events::Spell_periodic_missed>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
+  if (columns.size() < 13) {
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   const std::string_view type = columns[11];
 
   if (type == "ABSORB") {
+    if (columns.size() < 15) {
+      error = Parse_error::not_enough_columns;
+      return {};
+    }
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0, 8)), //combat header
-      Parse<events::Spell_info>::parse(columns.subspan(8, 3)),
+      Parse<events::Combat_header>::parse(columns.subspan(0, 8), error), //combat header
+      Parse<events::Spell_info>::parse(columns.subspan(8, 3), error),
       type,
-      helpers::parseInt<bool>(columns[12]),
-      helpers::parseInt<std::uint64_t>(columns[13]),
-      helpers::parseInt<std::uint64_t>(columns[14])
+      helpers::parseInt<bool>(columns[12], error),
+      helpers::parseInt<std::uint64_t>(columns[13], error),
+      helpers::parseInt<std::uint64_t>(columns[14], error),
+      false
     };
   } else {
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0, 8)), //combat header
-      Parse<events::Spell_info>::parse(columns.subspan(8, 3)),
+      Parse<events::Combat_header>::parse(columns.subspan(0, 8), error), //combat header
+      Parse<events::Spell_info>::parse(columns.subspan(8, 3), error),
       type,
-      helpers::parseInt<bool>(columns[12]),
+      helpers::parseInt<bool>(columns[12], error),
       0,
-      0
+      0,
+      false
     };
   }
 }
-events::Spell_periodic_heal clogparser::internal::Parse<events::Spell_periodic_heal>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_periodic_heal clogparser::internal::Parse<events::Spell_periodic_heal>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Spell_periodic_heal::COLUMNS_COUNT) {
-    throw std::exception{"Not enough columns for a spell periodic heal"};
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0,8)),
-    Parse<events::Spell_info>::parse(columns.subspan(8,3)),
-    Parse<events::Advanced_info>::parse(columns.subspan(11, 17)),
-    Parse<events::Heal>::parse(columns.subspan(28, 5))
+    Parse<events::Combat_header>::parse(columns.subspan(0,8), error),
+    Parse<events::Spell_info>::parse(columns.subspan(8,3), error),
+    Parse<events::Advanced_info>::parse(columns.subspan(11, 17), error),
+    Parse<events::Heal>::parse(columns.subspan(28, 5), error)
   };
 }
-events::Spell_absorbed clogparser::internal::Parse<events::Spell_absorbed>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_absorbed clogparser::internal::Parse<events::Spell_absorbed>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() == 18) {
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0, 8)),
+      Parse<events::Combat_header>::parse(columns.subspan(0, 8), error),
       std::nullopt,
-      Parse<events::Unit>::parse(columns.subspan(8, 4)),
-      Parse<events::Spell_info>::parse(columns.subspan(12, 3)),
-      helpers::parseInt<std::int64_t>(columns[15]),
-      helpers::parseInt<std::uint64_t>(columns[16]),
-      helpers::parseInt<bool>(columns[17])
+      Parse<events::Unit>::parse(columns.subspan(8, 4), error),
+      Parse<events::Spell_info>::parse(columns.subspan(12, 3), error),
+      helpers::parseInt<std::int64_t>(columns[15], error),
+      helpers::parseInt<std::uint64_t>(columns[16], error),
+      helpers::parseInt<bool>(columns[17], error)
     };
   } else if (columns.size() == 21) {
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0, 8)),
-      Parse<events::Spell_info>::parse(columns.subspan(8, 3)),
-      Parse<events::Unit>::parse(columns.subspan(11, 4)),
-      Parse<events::Spell_info>::parse(columns.subspan(15, 3)),
-      helpers::parseInt<std::int64_t>(columns[18]),
-      helpers::parseInt<std::uint64_t>(columns[19]),
-      helpers::parseInt<bool>(columns[20])
+      Parse<events::Combat_header>::parse(columns.subspan(0, 8), error),
+      Parse<events::Spell_info>::parse(columns.subspan(8, 3), error),
+      Parse<events::Unit>::parse(columns.subspan(11, 4), error),
+      Parse<events::Spell_info>::parse(columns.subspan(15, 3), error),
+      helpers::parseInt<std::int64_t>(columns[18], error),
+      helpers::parseInt<std::uint64_t>(columns[19], error),
+      helpers::parseInt<bool>(columns[20], error)
     };
   } else {
-    throw std::exception{"Not enough columns for a spell absorbed"};
+    error = Parse_error::not_enough_columns;
+    return {};
+  }
+}
+template<>
+events::Spell_heal_absorbed clogparser::internal::Parse<events::Spell_heal_absorbed>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
+  if (columns.size() < events::Spell_heal_absorbed::COLUMNS_COUNT) {
+    error = Parse_error::not_enough_columns;
+    return {};
   }
+
+  return {
+    Parse<events::Combat_header>::parse(columns.subspan(0, 8), error),
+    Parse<events::Spell_info>::parse(columns.subspan(8, 3), error),
+    Parse<events::Unit>::parse(columns.subspan(11, 4), error),
+    Parse<events::Spell_info>::parse(columns.subspan(15, 3), error),
+    helpers::parseInt<std::int64_t>(columns[18], error),
+    helpers::parseInt<std::uint64_t>(columns[19], error)
+  };
 }
-events::Swing_missed clogparser::internal::Parse<events::Swing_missed>::parse(helpers::Columns_span columns) {
-  if (columns.size() < 9) {
-    throw std::exception("Not enough columns for swing misses");
+template<>
+events::Swing_missed clogparser::internal::Parse<events::Swing_missed>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
+  if (columns.size() < 10) {
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   const std::string_view type = columns[8];
 
   if (type == "ABSORB") {
+    if (columns.size() < 13) {
+      error = Parse_error::not_enough_columns;
+      return {};
+    }
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0, 8)),
+      Parse<events::Combat_header>::parse(columns.subspan(0, 8), error),
       type,
-      helpers::parseInt<bool>(columns[9]),
-      helpers::parseInt<std::uint64_t>(columns[10]),
-      helpers::parseInt<std::uint64_t>(columns[11]),
-      helpers::parseInt<bool>(columns[12])
+      helpers::parseInt<bool>(columns[9], error),
+      helpers::parseInt<std::uint64_t>(columns[10], error),
+      helpers::parseInt<std::uint64_t>(columns[11], error),
+      helpers::parseInt<bool>(columns[12], error)
     };
   } else {
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0, 8)),
+      Parse<events::Combat_header>::parse(columns.subspan(0, 8), error),
       type,
-      helpers::parseInt<bool>(columns[9]),
+      helpers::parseInt<bool>(columns[9], error),
       0,
       0,
       false
     };
   }
 }
-events::Swing_damage clogparser::internal::Parse<events::Swing_damage>::parse(helpers::Columns_span columns) {
+template<>
+events::Swing_damage clogparser::internal::Parse<events::Swing_damage>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Swing_damage::COLUMNS_COUNT) {
-    throw std::exception{ "Not enough columns for a swing damage" };
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0, 8)), //combat header
-    Parse<events::Advanced_info>::parse(columns.subspan(8, 17)),
-    Parse<events::Damage>::parse(columns.subspan(25, 10))
+    Parse<events::Combat_header>::parse(columns.subspan(0, 8), error), //combat header
+    Parse<events::Advanced_info>::parse(columns.subspan(8, 17), error),
+    Parse<events::Damage>::parse(columns.subspan(25, 10), error)
   };
 }
-events::Swing_damage_landed clogparser::internal::Parse<events::Swing_damage_landed>::parse(helpers::Columns_span columns) {
+template<>
+events::Swing_damage_landed clogparser::internal::Parse<events::Swing_damage_landed>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Swing_damage_landed::COLUMNS_COUNT) {
-    throw std::exception{"Not enough columns for a swing damage landed"};
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0, 8)), //combat header
-    Parse<events::Advanced_info>::parse(columns.subspan(8, 17)),
-    Parse<events::Damage>::parse(columns.subspan(25, 10))
+    Parse<events::Combat_header>::parse(columns.subspan(0, 8), error), //combat header
+    Parse<events::Advanced_info>::parse(columns.subspan(8, 17), error),
+    Parse<events::Damage>::parse(columns.subspan(25, 10), error)
   };
 }
-events::Swing_damage_landed_support clogparser::internal::Parse<events::Swing_damage_landed_support>::parse(helpers::Columns_span columns) {
+template<>
+events::Swing_damage_landed_support clogparser::internal::Parse<events::Swing_damage_landed_support>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Swing_damage_landed_support::COLUMNS_COUNT) {
-    throw std::exception{ "Not enough columns for a swing damage landed support" };
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0, 8)),
-    Parse<events::Spell_info>::parse(columns.subspan(8,3)),
-    Parse<events::Advanced_info>::parse(columns.subspan(11,17)),
-    Parse<events::Damage>::parse(columns.subspan(28,10)),
+    Parse<events::Combat_header>::parse(columns.subspan(0, 8), error),
+    Parse<events::Spell_info>::parse(columns.subspan(8,3), error),
+    Parse<events::Advanced_info>::parse(columns.subspan(11,17), error),
+    Parse<events::Damage>::parse(columns.subspan(28,10), error),
     columns[38]
   };
 }
-events::Spell_missed clogparser::internal::Parse<events::Spell_missed>::parse(helpers::Columns_span columns) {
-  if (columns.size() < 12) {
-    throw std::exception("Not enough columns for spell missed");
+template<>
+events::Spell_missed clogparser::internal::Parse<events::Spell_missed>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
+  if (columns.size() < 13) {
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   const std::string_view type = columns[11];
 
   if (type == "ABSORB") {
+    if (columns.size() < 15) {
+      error = Parse_error::not_enough_columns;
+      return {};
+    }
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0, 8)), //combat header
-      Parse<events::Spell_info>::parse(columns.subspan(8, 3)),
+      Parse<events::Combat_header>::parse(columns.subspan(0, 8), error), //combat header
+      Parse<events::Spell_info>::parse(columns.subspan(8, 3), error),
       type,
-      helpers::parseInt<bool>(columns[12]),
-      helpers::parseInt<std::uint64_t>(columns[13]),
-      helpers::parseInt<std::uint64_t>(columns[14])
+      helpers::parseInt<bool>(columns[12], error),
+      helpers::parseInt<std::uint64_t>(columns[13], error),
+      helpers::parseInt<std::uint64_t>(columns[14], error)
     };
   } else {
     return {
-      Parse<events::Combat_header>::parse(columns.subspan(0, 8)), //combat header
-      Parse<events::Spell_info>::parse(columns.subspan(8, 3)),
+      Parse<events::Combat_header>::parse(columns.subspan(0, 8), error), //combat header
+      Parse<events::Spell_info>::parse(columns.subspan(8, 3), error),
       type,
-      helpers::parseInt<bool>(columns[12]),
+      helpers::parseInt<bool>(columns[12], error),
       0,
       0
     };
   }
 }
-events::Spell_damage clogparser::internal::Parse<events::Spell_damage>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_damage clogparser::internal::Parse<events::Spell_damage>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Spell_damage::COLUMNS_COUNT) {
-    throw std::exception{"Not enough columns for a spell periodic damage"};
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0, 8)), //combat header
-    Parse<events::Spell_info>::parse(columns.subspan(8, 3)),
-    Parse<events::Advanced_info>::parse(columns.subspan(11, 17)),
-    Parse<events::Damage>::parse(columns.subspan(28, 10))
+    Parse<events::Combat_header>::parse(columns.subspan(0, 8), error), //combat header
+    Parse<events::Spell_info>::parse(columns.subspan(8, 3), error),
+    Parse<events::Advanced_info>::parse(columns.subspan(11, 17), error),
+    Parse<events::Damage>::parse(columns.subspan(28, 10), error)
   };
 }
-events::Spell_damage_support clogparser::internal::Parse<events::Spell_damage_support>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_damage_support clogparser::internal::Parse<events::Spell_damage_support>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Spell_damage_support::COLUMNS_COUNT) {
-    throw std::exception{ "Not enough columns for a spell damage support" };
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0, 8)),
-    Parse<events::Spell_info>::parse(columns.subspan(8,3)),
-    Parse<events::Advanced_info>::parse(columns.subspan(11,17)),
-    Parse<events::Damage>::parse(columns.subspan(28,10)),
+    Parse<events::Combat_header>::parse(columns.subspan(0, 8), error),
+    Parse<events::Spell_info>::parse(columns.subspan(8,3), error),
+    Parse<events::Advanced_info>::parse(columns.subspan(11,17), error),
+    Parse<events::Damage>::parse(columns.subspan(28,10), error),
     columns[38]
   };
 }
-events::Spell_heal clogparser::internal::Parse<events::Spell_heal>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_heal clogparser::internal::Parse<events::Spell_heal>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Spell_heal::COLUMNS_COUNT) {
-    throw std::exception{"Not enough columns for a spell heal"};
+    error = Parse_error::not_enough_columns;
+    return {};
   }
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0, 8)),
-    Parse<events::Spell_info>::parse(columns.subspan(8, 3)),
-    Parse<events::Advanced_info>::parse(columns.subspan(11, 17)),
-    Parse<events::Heal>::parse(columns.subspan(28, 5))
+    Parse<events::Combat_header>::parse(columns.subspan(0, 8), error),
+    Parse<events::Spell_info>::parse(columns.subspan(8, 3), error),
+    Parse<events::Advanced_info>::parse(columns.subspan(11, 17), error),
+    Parse<events::Heal>::parse(columns.subspan(28, 5), error)
   };
 }
-events::Spell_cast_success clogparser::internal::Parse<events::Spell_cast_success>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_cast_success clogparser::internal::Parse<events::Spell_cast_success>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Spell_cast_success::COLUMNS_COUNT) {
-    throw std::exception{"Not enough columns for a spell cast success"};
+    error = Parse_error::not_enough_columns;
+    return {};
   }
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0, 8)),
-    Parse<events::Spell_info>::parse(columns.subspan(8, 3)),
-    Parse<events::Advanced_info>::parse(columns.subspan(11, 17))
+    Parse<events::Combat_header>::parse(columns.subspan(0, 8), error),
+    Parse<events::Spell_info>::parse(columns.subspan(8, 3), error),
+    Parse<events::Advanced_info>::parse(columns.subspan(11, 17), error)
   };
 }
-events::Encounter_start clogparser::internal::Parse<events::Encounter_start>::parse(helpers::Columns_span columns) {
+template<>
+events::Encounter_start clogparser::internal::Parse<events::Encounter_start>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Encounter_start::COLUMNS_COUNT) {
-    throw std::exception("Not enough columns for an encounter start");
+    error = Parse_error::not_enough_columns;
+    return {};
   }
   return {
-    helpers::parseInt<std::int32_t>(columns[0]),
+    helpers::parseInt<std::int32_t>(columns[0], error),
     columns[1],
-    static_cast<Difficulty>(helpers::parseInt<std::uint8_t>(columns[2])),
-    helpers::parseInt<std::uint8_t>(columns[3]),
-    helpers::parseInt<std::uint64_t>(columns[4])
+    static_cast<Difficulty>(helpers::parseInt<std::uint8_t>(columns[2], error)),
+    helpers::parseInt<std::uint8_t>(columns[3], error),
+    helpers::parseInt<std::uint64_t>(columns[4], error)
   };
 }
-events::Encounter_end clogparser::internal::Parse<events::Encounter_end>::parse(helpers::Columns_span columns) {
+template<>
+events::Encounter_end clogparser::internal::Parse<events::Encounter_end>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Encounter_end::COLUMNS_COUNT) {
-    throw std::exception("Not enough columns for an encounter end");
+    error = Parse_error::not_enough_columns;
+    return {};
   }
   return {
-    helpers::parseInt<std::int32_t>(columns[0]),
+    helpers::parseInt<std::int32_t>(columns[0], error),
     columns[1],
-    static_cast<Difficulty>(helpers::parseInt<std::uint8_t>(columns[2])),
-    helpers::parseInt<std::uint8_t>(columns[3]),
-    helpers::parseInt<bool>(columns[4]),
-    helpers::parseInt<std::uint64_t>(columns[5])
+    static_cast<Difficulty>(helpers::parseInt<std::uint8_t>(columns[2], error)),
+    helpers::parseInt<std::uint8_t>(columns[3], error),
+    helpers::parseInt<bool>(columns[4], error),
+    helpers::parseInt<std::uint64_t>(columns[5], error)
   };
 }
-events::Combatant_info clogparser::internal::Parse<events::Combatant_info>::parse(helpers::Columns_span columns) {
+events::Combatant_info clogparser::internal::Parse<events::Combatant_info>::parse(helpers::Columns_span columns, Bump_arena& arena, Parse_error& error) {
   if (columns.size() < events::Combatant_info::COLUMNS_COUNT) {
-    throw std::exception{"Not enough columns for a combatant info"};
+    error = Parse_error::not_enough_columns;
+    return {};
   }
   
   return {
-    columns[0],
-    FactionId{ helpers::parseInt<std::underlying_type_t<FactionId>>(columns[1])},
-    Stats{
-      helpers::parseInt<std::int32_t>(columns[2]),
-      helpers::parseInt<std::int32_t>(columns[3]),
-      helpers::parseInt<std::int32_t>(columns[4]),
-      helpers::parseInt<std::int32_t>(columns[5]),
-      helpers::parseInt<std::int32_t>(columns[6]),
-      helpers::parseInt<std::int32_t>(columns[7]),
-      helpers::parseInt<std::int32_t>(columns[8]),
-      helpers::parseInt<std::int32_t>(columns[9]),
-      helpers::parseInt<std::int32_t>(columns[10]),
-      helpers::parseInt<std::int32_t>(columns[11]),
-      helpers::parseInt<std::int32_t>(columns[12]),
-      helpers::parseInt<std::int32_t>(columns[13]),
-      helpers::parseInt<std::int32_t>(columns[14]),
-      helpers::parseInt<std::int32_t>(columns[15]),
-      helpers::parseInt<std::int32_t>(columns[16]),
-      helpers::parseInt<std::int32_t>(columns[17]),
-      helpers::parseInt<std::int32_t>(columns[18]),
-      helpers::parseInt<std::int32_t>(columns[19]),
-      helpers::parseInt<std::int32_t>(columns[20]),
-      helpers::parseInt<std::int32_t>(columns[21]),
-      helpers::parseInt<std::int32_t>(columns[22]),
-    },
-    SpecId{ helpers::parseInt<std::underlying_type_t<SpecId>>(columns[23])},
-    parse_talents(columns[24]),
-    clogparser::helpers::parse_array(columns[25]),
-    parse_items(columns[26]),
-    parse_interesting_auras(columns[27]),
-    helpers::parseInt<std::uint32_t>(columns[28]),
-    helpers::parseInt<std::uint32_t>(columns[29]),
-    helpers::parseInt<std::uint32_t>(columns[30]),
-    helpers::parseInt<std::uint32_t>(columns[31])
+    helpers::parse_guid(columns[0], error),
+    FactionId{ helpers::parseInt<std::underlying_type_t<FactionId>>(columns[1], error)},
+    parse_stats(columns.subspan(2, Stats::size), error),
+    SpecId{ helpers::parseInt<std::underlying_type_t<SpecId>>(columns[23], error)},
+    parse_talents(arena, columns[24], error),
+    parse_pvp_talents(arena, columns[25], error),
+    parse_items(arena, columns[26], error),
+    parse_interesting_auras(arena, columns[27], error),
+    helpers::parseInt<std::uint32_t>(columns[28], error),
+    helpers::parseInt<std::uint32_t>(columns[29], error),
+    helpers::parseInt<std::uint32_t>(columns[30], error),
+    helpers::parseInt<std::uint32_t>(columns[31], error)
   };
 }
-events::Spell_summon clogparser::internal::Parse<events::Spell_summon>::parse(helpers::Columns_span columns) {
+events::Combatant_info clogparser::internal::keep_arrays(Bump_arena& arena, events::Combatant_info const& event) {
+  events::Combatant_info returning = event;
+  returning.talents = arena.copy(event.talents);
+  returning.pvp_talents = arena.copy(event.pvp_talents);
+  const auto items = arena.allocate<Item>(event.items.size());
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    items[i] = event.items[i];
+    items[i].bonus_ids = arena.copy(event.items[i].bonus_ids);
+    items[i].gem_ids = arena.copy(event.items[i].gem_ids);
+  }
+  returning.items = items;
+  returning.interesting_auras = arena.copy(event.interesting_auras);
+  return returning;
+}
+template<>
+events::Spell_summon clogparser::internal::Parse<events::Spell_summon>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Spell_summon::COLUMNS_COUNT) {
-    throw std::exception{ "Not enough columns for a spell summon" };
+    error = Parse_error::not_enough_columns;
+    return {};
   }
 
   return {
-    Parse<events::Unit>::parse(columns.subspan(0,4)),
-    Parse<events::Unit>::parse(columns.subspan(4,4)),
-    Parse<events::Spell_info>::parse(columns.subspan(8,3))
+    Parse<events::Unit>::parse(columns.subspan(0,4), error),
+    Parse<events::Unit>::parse(columns.subspan(4,4), error),
+    Parse<events::Spell_info>::parse(columns.subspan(8,3), error)
   };
 }
-events::Zone_change clogparser::internal::Parse<events::Zone_change>::parse(helpers::Columns_span columns) {
+template<>
+events::Zone_change clogparser::internal::Parse<events::Zone_change>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Zone_change::COLUMNS_COUNT) {
-    throw std::exception("Not enough columns for a zone change");
+    error = Parse_error::not_enough_columns;
+    return {};
   }
   return {
-    helpers::parseInt<std::uint64_t>(columns[0]),
+    helpers::parseInt<std::uint64_t>(columns[0], error),
     columns[1],
-    helpers::parseInt<std::uint64_t>(columns[2])
+    helpers::parseInt<std::uint64_t>(columns[2], error)
   };
 }
-events::Map_change clogparser::internal::Parse<events::Map_change>::parse(helpers::Columns_span columns) {
+template<>
+events::Map_change clogparser::internal::Parse<events::Map_change>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Map_change::COLUMNS_COUNT) {
-    throw std::exception("Not enough columns for a map change");
+    error = Parse_error::not_enough_columns;
+    return {};
   }
   return {
-    helpers::parseInt<std::uint64_t>(columns[0]),
+    helpers::parseInt<std::uint64_t>(columns[0], error),
     columns[1],
-    helpers::parseInt<float>(columns[2]),
-    helpers::parseInt<float>(columns[3]),
-    helpers::parseInt<float>(columns[4]),
-    helpers::parseInt<float>(columns[5])
+    helpers::parseInt<float>(columns[2], error),
+    helpers::parseInt<float>(columns[3], error),
+    helpers::parseInt<float>(columns[4], error),
+    helpers::parseInt<float>(columns[5], error)
   };
 }
-events::Unit_died clogparser::internal::Parse<events::Unit_died>::parse(helpers::Columns_span columns) {
+template<>
+events::Unit_died clogparser::internal::Parse<events::Unit_died>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Unit_died::COLUMNS_COUNT) {
-    throw std::exception("Not enough columns for a unit died");
+    error = Parse_error::not_enough_columns;
+    return {};
   }
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0,8)),
-    helpers::parseInt<bool>(columns[8])
+    Parse<events::Combat_header>::parse(columns.subspan(0,8), error),
+    helpers::parseInt<bool>(columns[8], error)
   };
 }
-events::Spell_resurrect clogparser::internal::Parse<events::Spell_resurrect>::parse(helpers::Columns_span columns) {
+template<>
+events::Spell_resurrect clogparser::internal::Parse<events::Spell_resurrect>::parse(helpers::Columns_span columns, Parse_error& error) noexcept {
   if (columns.size() < events::Spell_resurrect::COLUMNS_COUNT) {
-    throw std::exception("Not enough columns for a spell resurrect");
+    error = Parse_error::not_enough_columns;
+    return {};
   }
   return {
-    Parse<events::Combat_header>::parse(columns.subspan(0,8)),
-    Parse<events::Spell_info>::parse(columns.subspan(8,3))
+    Parse<events::Combat_header>::parse(columns.subspan(0,8), error),
+    Parse<events::Spell_info>::parse(columns.subspan(8,3), error)
   };
 }
 
-std::string_view clogparser::String_store::get(std::string_view in) noexcept {
-  return *store_.emplace(in).first;
-}
-
-events::Combat_log_version clogparser::String_store::get(events::Combat_log_version in) {
+template<typename Store>
+events::Combat_log_version clogparser::Basic_string_store<Store>::get(events::Combat_log_version in) {
   return in;
 }
-events::Spell_aura_applied clogparser::String_store::get(events::Spell_aura_applied in) {
+template<typename Store>
+events::Spell_aura_applied clogparser::Basic_string_store<Store>::get(events::Spell_aura_applied in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.spell),
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
     in.aura_type,
     in.remaining_points
   };
 }
-events::Spell_aura_applied_dose clogparser::String_store::get(events::Spell_aura_applied_dose in) {
+template<typename Store>
+events::Spell_aura_applied_dose clogparser::Basic_string_store<Store>::get(events::Spell_aura_applied_dose in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.spell),
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
     in.aura_type,
     in.new_dosage
   };
 }
-events::Spell_aura_refresh clogparser::String_store::get(events::Spell_aura_refresh in) {
+template<typename Store>
+events::Spell_aura_refresh clogparser::Basic_string_store<Store>::get(events::Spell_aura_refresh in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.spell),
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
     in.aura_type,
     in.remaining_points
   };
 }
-events::Spell_aura_removed clogparser::String_store::get(events::Spell_aura_removed in) {
+template<typename Store>
+events::Spell_aura_removed clogparser::Basic_string_store<Store>::get(events::Spell_aura_removed in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.spell),
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
     in.aura_type,
     in.remaining_points
   };
 }
-events::Spell_aura_removed_dose clogparser::String_store::get(events::Spell_aura_removed_dose in) {
+template<typename Store>
+events::Spell_aura_removed_dose clogparser::Basic_string_store<Store>::get(events::Spell_aura_removed_dose in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.spell),
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
     in.aura_type,
     in.new_dosage
   };
 }
-events::Spell_periodic_damage clogparser::String_store::get(events::Spell_periodic_damage in) {
+template<typename Store>
+events::Spell_periodic_damage clogparser::Basic_string_store<Store>::get(events::Spell_periodic_damage in) {
+  return {
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
+    ::convert(self_(), in.advanced),
+    ::convert(self_(), in.damage)
+  };
+}
+template<typename Store>
+events::Spell_periodic_damage_support clogparser::Basic_string_store<Store>::get(events::Spell_periodic_damage_support in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.spell),
-    ::convert(*this, in.advanced),
-    ::convert(*this, in.damage)
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
+    ::convert(self_(), in.advanced),
+    ::convert(self_(), in.damage),
+    self_().get(in.supporter)
   };
 }
-events::Spell_periodic_missed clogparser::String_store::get(events::Spell_periodic_missed in) {
+template<typename Store>
+events::Spell_periodic_missed clogparser::Basic_string_store<Store>::get(events::Spell_periodic_missed in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.spell),
-    get(in.type),
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
+    self_().get(in.type),
     in.unk1,
     in.final,
     in.initial,
     in.unk2
   };
 }
-events::Spell_periodic_heal clogparser::String_store::get(events::Spell_periodic_heal in) {
+template<typename Store>
+events::Spell_periodic_heal clogparser::Basic_string_store<Store>::get(events::Spell_periodic_heal in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.spell),
-    ::convert(*this, in.advanced),
-    ::convert(*this, in.heal)
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
+    ::convert(self_(), in.advanced),
+    ::convert(self_(), in.heal)
   };
 }
-events::Spell_absorbed clogparser::String_store::get(events::Spell_absorbed in) {
+template<typename Store>
+events::Spell_absorbed clogparser::Basic_string_store<Store>::get(events::Spell_absorbed in) {
   if (in.dmg_spell.has_value()) {
     return {
-      ::convert(*this, in.combat_header),
-      ::convert(*this, in.dmg_spell.value()),
-      ::convert(*this, in.absorber),
-      ::convert(*this, in.absorber_spell),
+      ::convert(self_(), in.combat_header),
+      ::convert(self_(), in.dmg_spell.value()),
+      ::convert(self_(), in.absorber),
+      ::convert(self_(), in.absorber_spell),
       in.absorbed,
       in.unmitigated,
       in.critical
     };
   } else {
     return {
-      ::convert(*this, in.combat_header),
+      ::convert(self_(), in.combat_header),
       std::nullopt,
-      ::convert(*this, in.absorber),
-      ::convert(*this, in.absorber_spell),
+      ::convert(self_(), in.absorber),
+      ::convert(self_(), in.absorber_spell),
       in.absorbed,
       in.unmitigated,
       in.critical
     };
   }
 }
-events::Swing_missed clogparser::String_store::get(events::Swing_missed in) {
+template<typename Store>
+events::Spell_heal_absorbed clogparser::Basic_string_store<Store>::get(events::Spell_heal_absorbed in) {
   return {
-    ::convert(*this, in.combat_header),
-    get(in.type),
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.absorbing_spell),
+    ::convert(self_(), in.absorbed),
+    ::convert(self_(), in.absorbed_spell),
+    in.absorbed_amount,
+    in.unmitigated
+  };
+}
+template<typename Store>
+events::Swing_missed clogparser::Basic_string_store<Store>::get(events::Swing_missed in) {
+  return {
+    ::convert(self_(), in.combat_header),
+    self_().get(in.type),
     in.unk1,
     in.final,
     in.initial,
     in.unk2
   };
 }
-events::Swing_damage_landed clogparser::String_store::get(events::Swing_damage_landed in) {
+template<typename Store>
+events::Swing_damage clogparser::Basic_string_store<Store>::get(events::Swing_damage in) {
+  return {
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.advanced),
+    ::convert(self_(), in.damage)
+  };
+}
+template<typename Store>
+events::Swing_damage_landed clogparser::Basic_string_store<Store>::get(events::Swing_damage_landed in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.advanced),
-    ::convert(*this, in.damage)
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.advanced),
+    ::convert(self_(), in.damage)
   };
 }
-events::Spell_missed clogparser::String_store::get(events::Spell_missed in) {
+template<typename Store>
+events::Swing_damage_landed_support clogparser::Basic_string_store<Store>::get(events::Swing_damage_landed_support in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.spell),
-    get(in.type),
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
+    ::convert(self_(), in.advanced),
+    ::convert(self_(), in.damage),
+    self_().get(in.supporter)
+  };
+}
+template<typename Store>
+events::Spell_missed clogparser::Basic_string_store<Store>::get(events::Spell_missed in) {
+  return {
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
+    self_().get(in.type),
     in.offhand,
     in.final,
     in.initial
   };
 }
-events::Spell_damage clogparser::String_store::get(events::Spell_damage in) {
+template<typename Store>
+events::Spell_damage clogparser::Basic_string_store<Store>::get(events::Spell_damage in) {
+  return {
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
+    ::convert(self_(), in.advanced),
+    ::convert(self_(), in.damage)
+  };
+}
+template<typename Store>
+events::Spell_damage_support clogparser::Basic_string_store<Store>::get(events::Spell_damage_support in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.spell),
-    ::convert(*this, in.advanced),
-    ::convert(*this, in.damage)
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
+    ::convert(self_(), in.advanced),
+    ::convert(self_(), in.damage),
+    self_().get(in.supporter)
   };
 }
-events::Spell_heal clogparser::String_store::get(events::Spell_heal in) {
+template<typename Store>
+events::Spell_heal clogparser::Basic_string_store<Store>::get(events::Spell_heal in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.spell),
-    ::convert(*this, in.advanced),
-    ::convert(*this, in.heal)
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
+    ::convert(self_(), in.advanced),
+    ::convert(self_(), in.heal)
   };
 }
-events::Spell_cast_success clogparser::String_store::get(events::Spell_cast_success in) {
+template<typename Store>
+events::Spell_cast_success clogparser::Basic_string_store<Store>::get(events::Spell_cast_success in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.spell),
-    ::convert(*this, in.advanced)
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell),
+    ::convert(self_(), in.advanced)
   };
 }
-events::Encounter_start clogparser::String_store::get(events::Encounter_start in) {
+template<typename Store>
+events::Encounter_start clogparser::Basic_string_store<Store>::get(events::Encounter_start in) {
   return {
     in.encounter_id,
-    get(in.encounter_name),
+    self_().get(in.encounter_name),
     in.difficulty_id,
     in.instance_size,
     in.instance_id
   };
 }
-events::Encounter_end clogparser::String_store::get(events::Encounter_end in) {
+template<typename Store>
+events::Encounter_end clogparser::Basic_string_store<Store>::get(events::Encounter_end in) {
   return {
     in.encounter_id,
-    get(in.encounter_name),
+    self_().get(in.encounter_name),
     in.difficulty_id,
     in.instance_size,
     in.success,
     in.instance_id
   };
 }
-events::Combatant_info::Interesting_aura clogparser::String_store::get(events::Combatant_info::Interesting_aura in) {
+template<typename Store>
+events::Combatant_info::Interesting_aura clogparser::Basic_string_store<Store>::get(events::Combatant_info::Interesting_aura in) {
   return {
-    get(in.caster_guid),
+    in.caster_guid,
     in.spell_id
   };
 }
-events::Combatant_info clogparser::String_store::get(events::Combatant_info in) {
+template<typename Store>
+clogparser::Item clogparser::Basic_string_store<Store>::get(Item in) {
+  in.bonus_ids = self_().get(in.bonus_ids);
+  in.gem_ids = self_().get(in.gem_ids);
+  return in;
+}
+template<typename Store>
+events::Combatant_info clogparser::Basic_string_store<Store>::get(events::Combatant_info in) {
   return {
-    get(in.guid),
+    in.guid,
     in.faction,
     in.stats,
     in.current_spec_id,
-    in.talents,
-    get(in.pvp_talents),
-    in.items,
-    get(in.interesting_auras),
+    self_().get(in.talents),
+    self_().get(in.pvp_talents),
+    self_().get(in.items),
+    self_().get(in.interesting_auras),
     in.honor_level,
     in.season,
     in.rating,
     in.tier
   };
 }
-events::Spell_summon clogparser::String_store::get(events::Spell_summon in) {
+template<typename Store>
+clogparser::Deferred_combatant_info clogparser::Basic_string_store<Store>::get(Deferred_combatant_info in) {
+  in.talents_text = self_().get(in.talents_text);
+  in.pvp_talents_text = self_().get(in.pvp_talents_text);
+  in.items_text = self_().get(in.items_text);
+  in.interesting_auras_text = self_().get(in.interesting_auras_text);
+  return in;
+}
+template<typename Store>
+events::Spell_summon clogparser::Basic_string_store<Store>::get(events::Spell_summon in) {
   return {
-    ::convert(*this, in.summoner),
-    ::convert(*this, in.summoned),
-    ::convert(*this, in.spell)
+    ::convert(self_(), in.summoner),
+    ::convert(self_(), in.summoned),
+    ::convert(self_(), in.spell)
   };
 }
-events::Zone_change clogparser::String_store::get(events::Zone_change in) {
+template<typename Store>
+events::Zone_change clogparser::Basic_string_store<Store>::get(events::Zone_change in) {
   return {
     in.instance_id,
-    get(in.zone_name),
+    self_().get(in.zone_name),
     in.difficulty_id
   };
 }
-events::Map_change clogparser::String_store::get(events::Map_change in) {
+template<typename Store>
+events::Map_change clogparser::Basic_string_store<Store>::get(events::Map_change in) {
   return {
     in.map_id,
-    get(in.map_name),
+    self_().get(in.map_name),
     in.x_min,
     in.x_max,
     in.y_min,
     in.y_max
   };
 }
-events::Unit_died clogparser::String_store::get(events::Unit_died in) {
+template<typename Store>
+events::Unit_died clogparser::Basic_string_store<Store>::get(events::Unit_died in) {
   return {
-    ::convert(*this, in.combat_header),
+    ::convert(self_(), in.combat_header),
     in.unconscious_on_death
   };
 }
-events::Spell_resurrect clogparser::String_store::get(events::Spell_resurrect in) {
+template<typename Store>
+events::Spell_resurrect clogparser::Basic_string_store<Store>::get(events::Spell_resurrect in) {
   return {
-    ::convert(*this, in.combat_header),
-    ::convert(*this, in.spell)
+    ::convert(self_(), in.combat_header),
+    ::convert(self_(), in.spell)
   };
 }
 
+std::string_view clogparser::String_store::get(std::string_view in) {
+  return store_.intern(in).str;
+}
+
 void clogparser::String_store::clear() {
   store_.clear();
+  arrays_.clear();
 }
+
+std::string_view clogparser::Concurrent_string_store::get(std::string_view in) {
+  return store_.intern(in);
+}
+
+void clogparser::Concurrent_string_store::clear() {
+  store_.clear();
+  arrays_.clear();
+}
+
+template struct clogparser::Basic_string_store<clogparser::String_store>;
+template struct clogparser::Basic_string_store<clogparser::Concurrent_string_store>;
@@ -0,0 +1,24 @@
+#include <clogparser/payload_arena.hpp>
+
+clogparser::Payload_arena::~Payload_arena() {
+  clear();
+}
+
+void clogparser::Payload_arena::clear() noexcept {
+  for (Destructor const& destructor : destructors_) {
+    destructor.destroy(destructor.object);
+  }
+  destructors_.clear();
+  blocks_.clear();
+  used_ = BLOCK_SIZE;
+}
+
+clogparser::Payload_arena::Offset clogparser::Payload_arena::allocate_(std::size_t size, std::size_t alignment) {
+  std::size_t start = (used_ + alignment - 1) & ~(alignment - 1);
+  if (start + size > BLOCK_SIZE) {
+    blocks_.push_back(std::make_unique_for_overwrite<std::byte[]>(BLOCK_SIZE));
+    start = 0;
+  }
+  used_ = start + size;
+  return static_cast<Offset>(blocks_.size() - 1) * BLOCK_SIZE + start;
+}
@@ -0,0 +1,438 @@
+#include <clogparser/scanner.hpp>
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CLOGPARSER_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(CLOGPARSER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CLOGPARSER_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CLOGPARSER_TARGET(isa)
+#endif
+
+namespace {
+  using clogparser::helpers::Line_masks;
+  using clogparser::helpers::Column_masks;
+  using clogparser::helpers::Event_masks;
+  using clogparser::helpers::Simd_level;
+
+  constexpr std::size_t BLOCK_SIZE = 64;
+
+  using Line_masks_kernel = Line_masks(*)(char const*, char, char) noexcept;
+  using Column_masks_kernel = Column_masks(*)(char const*) noexcept;
+  using Event_masks_kernel = Event_masks(*)(char const*, std::string_view) noexcept;
+
+  Line_masks line_masks_scalar(char const* block, char delim, char quote) noexcept {
+    Line_masks returning{ 0, 0 };
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+      returning.delim |= static_cast<std::uint64_t>(block[i] == delim) << i;
+      returning.quote |= static_cast<std::uint64_t>(block[i] == quote) << i;
+    }
+    return returning;
+  }
+
+  Column_masks column_masks_scalar(char const* block) noexcept {
+    Column_masks returning{ 0, 0, 0, 0 };
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+      const char c = block[i];
+      returning.comma |= static_cast<std::uint64_t>(c == ',') << i;
+      returning.quote |= static_cast<std::uint64_t>(c == '"') << i;
+      returning.open |= static_cast<std::uint64_t>(c == '[' || c == '(') << i;
+      returning.close |= static_cast<std::uint64_t>(c == ']' || c == ')') << i;
+    }
+    return returning;
+  }
+
+  Event_masks event_masks_scalar(char const* block, std::string_view leads) noexcept {
+    Event_masks returning{ 0, 0 };
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+      returning.space |= static_cast<std::uint64_t>(block[i] == ' ') << i;
+      returning.lead |= static_cast<std::uint64_t>(leads.find(block[i]) != std::string_view::npos) << i;
+    }
+    return returning;
+  }
+
+#ifdef CLOGPARSER_X86
+  CLOGPARSER_TARGET("sse2") std::uint64_t mask_16(__m128i in, __m128i against) noexcept {
+    return static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(in, against)));
+  }
+
+  CLOGPARSER_TARGET("sse2") Line_masks line_masks_sse2(char const* block, char delim, char quote) noexcept {
+    const __m128i delims = _mm_set1_epi8(delim);
+    const __m128i quotes = _mm_set1_epi8(quote);
+
+    Line_masks returning{ 0, 0 };
+    for (std::size_t i = 0; i < BLOCK_SIZE / 16; ++i) {
+      const __m128i in = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block + i * 16));
+      returning.delim |= mask_16(in, delims) << (i * 16);
+      returning.quote |= mask_16(in, quotes) << (i * 16);
+    }
+    return returning;
+  }
+
+  CLOGPARSER_TARGET("sse2") Column_masks column_masks_sse2(char const* block) noexcept {
+    const __m128i commas = _mm_set1_epi8(',');
+    const __m128i quotes = _mm_set1_epi8('"');
+    const __m128i square_opens = _mm_set1_epi8('[');
+    const __m128i round_opens = _mm_set1_epi8('(');
+    const __m128i square_closes = _mm_set1_epi8(']');
+    const __m128i round_closes = _mm_set1_epi8(')');
+
+    Column_masks returning{ 0, 0, 0, 0 };
+    for (std::size_t i = 0; i < BLOCK_SIZE / 16; ++i) {
+      const __m128i in = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block + i * 16));
+      returning.comma |= mask_16(in, commas) << (i * 16);
+      returning.quote |= mask_16(in, quotes) << (i * 16);
+      returning.open |= (mask_16(in, square_opens) | mask_16(in, round_opens)) << (i * 16);
+      returning.close |= (mask_16(in, square_closes) | mask_16(in, round_closes)) << (i * 16);
+    }
+    return returning;
+  }
+
+  CLOGPARSER_TARGET("sse2") Event_masks event_masks_sse2(char const* block, std::string_view leads) noexcept {
+    const __m128i spaces = _mm_set1_epi8(' ');
+
+    Event_masks returning{ 0, 0 };
+    for (std::size_t i = 0; i < BLOCK_SIZE / 16; ++i) {
+      const __m128i in = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block + i * 16));
+      returning.space |= mask_16(in, spaces) << (i * 16);
+      for (const char lead : leads) {
+        returning.lead |= mask_16(in, _mm_set1_epi8(lead)) << (i * 16);
+      }
+    }
+    return returning;
+  }
+
+  CLOGPARSER_TARGET("avx2") std::uint64_t mask_32(__m256i in, __m256i against) noexcept {
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(in, against)));
+  }
+
+  CLOGPARSER_TARGET("avx2") Line_masks line_masks_avx2(char const* block, char delim, char quote) noexcept {
+    const __m256i delims = _mm256_set1_epi8(delim);
+    const __m256i quotes = _mm256_set1_epi8(quote);
+
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block + 32));
+
+    return {
+      mask_32(lo, delims) | (mask_32(hi, delims) << 32),
+      mask_32(lo, quotes) | (mask_32(hi, quotes) << 32)
+    };
+  }
+
+  CLOGPARSER_TARGET("avx2") std::uint64_t mask_32_either(__m256i in, __m256i against_1, __m256i against_2) noexcept {
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(
+      _mm256_cmpeq_epi8(in, against_1),
+      _mm256_cmpeq_epi8(in, against_2))));
+  }
+
+  CLOGPARSER_TARGET("avx2") Column_masks column_masks_avx2(char const* block) noexcept {
+    const __m256i commas = _mm256_set1_epi8(',');
+    const __m256i quotes = _mm256_set1_epi8('"');
+    const __m256i square_opens = _mm256_set1_epi8('[');
+    const __m256i round_opens = _mm256_set1_epi8('(');
+    const __m256i square_closes = _mm256_set1_epi8(']');
+    const __m256i round_closes = _mm256_set1_epi8(')');
+
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block + 32));
+
+    return {
+      mask_32(lo, commas) | (mask_32(hi, commas) << 32),
+      mask_32(lo, quotes) | (mask_32(hi, quotes) << 32),
+      mask_32_either(lo, square_opens, round_opens) | (mask_32_either(hi, square_opens, round_opens) << 32),
+      mask_32_either(lo, square_closes, round_closes) | (mask_32_either(hi, square_closes, round_closes) << 32)
+    };
+  }
+
+  CLOGPARSER_TARGET("avx2") Event_masks event_masks_avx2(char const* block, std::string_view leads) noexcept {
+    const __m256i spaces = _mm256_set1_epi8(' ');
+
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block + 32));
+
+    Event_masks returning{
+      mask_32(lo, spaces) | (mask_32(hi, spaces) << 32),
+      0
+    };
+    for (const char lead : leads) {
+      const __m256i leading = _mm256_set1_epi8(lead);
+      returning.lead |= mask_32(lo, leading) | (mask_32(hi, leading) << 32);
+    }
+    return returning;
+  }
+#endif
+
+  Simd_level detect_simd_level() noexcept {
+#if defined(CLOGPARSER_X86) && defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 0);
+    const int max_leaf = regs[0];
+    __cpuid(regs, 1);
+    const bool has_sse2 = (regs[3] & (1 << 26)) != 0;
+    const bool os_saves_avx = (regs[2] & (1 << 27)) != 0
+      && (regs[2] & (1 << 28)) != 0
+      && (_xgetbv(0) & 0x6) == 0x6;
+    if (os_saves_avx && max_leaf >= 7) {
+      __cpuidex(regs, 7, 0);
+      if ((regs[1] & (1 << 5)) != 0) {
+        return Simd_level::avx2;
+      }
+    }
+    return has_sse2 ? Simd_level::sse2 : Simd_level::scalar;
+#elif defined(CLOGPARSER_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return Simd_level::avx2;
+    } else if (__builtin_cpu_supports("sse2")) {
+      return Simd_level::sse2;
+    }
+    return Simd_level::scalar;
+#else
+    return Simd_level::scalar;
+#endif
+  }
+
+  Line_masks_kernel line_masks_kernel() noexcept {
+    static const Line_masks_kernel kernel = []() noexcept -> Line_masks_kernel {
+      switch (clogparser::helpers::simd_level()) {
+#ifdef CLOGPARSER_X86
+      case Simd_level::avx2:
+        return &line_masks_avx2;
+      case Simd_level::sse2:
+        return &line_masks_sse2;
+#endif
+      default:
+        return &line_masks_scalar;
+      }
+    }();
+    return kernel;
+  }
+
+  Column_masks_kernel column_masks_kernel() noexcept {
+    static const Column_masks_kernel kernel = []() noexcept -> Column_masks_kernel {
+      switch (clogparser::helpers::simd_level()) {
+#ifdef CLOGPARSER_X86
+      case Simd_level::avx2:
+        return &column_masks_avx2;
+      case Simd_level::sse2:
+        return &column_masks_sse2;
+#endif
+      default:
+        return &column_masks_scalar;
+      }
+    }();
+    return kernel;
+  }
+
+  Event_masks_kernel event_masks_kernel() noexcept {
+    static const Event_masks_kernel kernel = []() noexcept -> Event_masks_kernel {
+      switch (clogparser::helpers::simd_level()) {
+#ifdef CLOGPARSER_X86
+      case Simd_level::avx2:
+        return &event_masks_avx2;
+      case Simd_level::sse2:
+        return &event_masks_sse2;
+#endif
+      default:
+        return &event_masks_scalar;
+      }
+    }();
+    return kernel;
+  }
+
+  //runs kernel over the 64 bytes at in[start], zero padding past the end of in
+  template<typename Kernel, typename... Args>
+  auto masks_at(std::string_view in, std::size_t start, Kernel kernel, Args... args) noexcept {
+    const std::size_t remaining = in.size() - start;
+    if (remaining >= BLOCK_SIZE) {
+      return kernel(in.data() + start, args...);
+    }
+
+    std::array<char, BLOCK_SIZE> padded{};
+    std::memcpy(padded.data(), in.data() + start, remaining);
+    return kernel(padded.data(), args...);
+  }
+
+  //bits for the bytes of a block that are actually inside in
+  std::uint64_t valid_bits(std::string_view in, std::size_t start) noexcept {
+    const std::size_t remaining = in.size() - start;
+    return remaining >= BLOCK_SIZE ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << remaining) - 1;
+  }
+
+  bool opens_column(char c) noexcept {
+    return c == '"' || c == '[' || c == '(';
+  }
+
+  char closer_of(char opener) noexcept {
+    switch (opener) {
+    case '[':
+      return ']';
+    case '(':
+      return ')';
+    default:
+      return opener;
+    }
+  }
+}
+
+clogparser::helpers::Simd_level clogparser::helpers::simd_level() noexcept {
+  static const Simd_level level = detect_simd_level();
+  return level;
+}
+
+clogparser::helpers::Column_masks clogparser::helpers::column_masks(char const* block) noexcept {
+  return column_masks_kernel()(block);
+}
+
+clogparser::helpers::Line_masks clogparser::helpers::line_masks(char const* block, char delim, char quote) noexcept {
+  return line_masks_kernel()(block, delim, quote);
+}
+
+clogparser::helpers::Event_masks clogparser::helpers::event_masks(char const* block, std::string_view leads) noexcept {
+  return event_masks_kernel()(block, leads);
+}
+
+std::size_t clogparser::helpers::find_event_start(std::string_view in, std::size_t start, std::string_view leads) noexcept {
+  const Event_masks_kernel kernel = event_masks_kernel();
+
+  //the spaces of the two bytes before the block, in the top bits
+  std::uint64_t spaces_before = 0;
+  if (start >= 1 && in[start - 1] == ' ') {
+    spaces_before |= std::uint64_t{ 1 } << 63;
+  }
+  if (start >= 2 && in[start - 2] == ' ') {
+    spaces_before |= std::uint64_t{ 1 } << 62;
+  }
+
+  for (std::size_t block_start = start; block_start < in.size(); block_start += BLOCK_SIZE) {
+    const Event_masks masks = masks_at(in, block_start, kernel, leads);
+    const std::uint64_t space = masks.space & valid_bits(in, block_start);
+
+    const std::uint64_t after_one = (space << 1) | (spaces_before >> 63);
+    const std::uint64_t after_two = (space << 2) | (spaces_before >> 62);
+    const std::uint64_t starts = masks.lead & after_one & after_two & valid_bits(in, block_start);
+    if (starts != 0) {
+      return block_start + static_cast<std::size_t>(std::countr_zero(starts));
+    }
+
+    spaces_before = space;
+  }
+  return std::string_view::npos;
+}
+
+std::size_t clogparser::helpers::find_unquoted(std::string_view in, std::size_t start, char delim, char quote, bool& in_quote) noexcept {
+  const Line_masks_kernel kernel = line_masks_kernel();
+
+  //all ones while inside quotes, so it can be xored straight onto a block's quote mask
+  std::uint64_t quote_state = in_quote ? ~std::uint64_t{ 0 } : 0;
+
+  for (std::size_t block_start = start; block_start < in.size(); block_start += BLOCK_SIZE) {
+    Line_masks masks = masks_at(in, block_start, kernel, delim, quote);
+    const std::uint64_t valid = valid_bits(in, block_start);
+    masks.delim &= valid;
+    masks.quote &= valid;
+
+    const std::uint64_t inside = prefix_xor(masks.quote) ^ quote_state;
+    const std::uint64_t delims = masks.delim & ~inside;
+    if (delims != 0) {
+      in_quote = false;
+      return block_start + static_cast<std::size_t>(std::countr_zero(delims));
+    }
+
+    //carry the state of the last byte into the next block
+    quote_state = (inside >> 63) != 0 ? ~std::uint64_t{ 0 } : 0;
+  }
+
+  in_quote = quote_state != 0;
+  return std::string_view::npos;
+}
+
+clogparser::helpers::Split_columns clogparser::helpers::split_columns(std::string_view in, std::span<std::string_view> returning) noexcept {
+  Split_columns result;
+  if (returning.empty()) {
+    result.rest = 0;
+    return result;
+  }
+
+  const Column_masks_kernel kernel = column_masks_kernel();
+
+  std::size_t column_start = 0;
+  //only brackets opening a column, or nested inside one, count. as before, a [ or ( in the
+  //middle of a plain column is just text
+  int depth = 0;
+  std::uint64_t quote_state = 0;
+
+  //writes the column ending at the comma at end, true once returning is full
+  const auto emit = [&](std::size_t end) noexcept {
+    std::string_view column = in.substr(column_start, end - column_start);
+    if (!column.empty() && opens_column(column.front())) {
+      column = column.substr(1, column.size() - 2);
+    }
+    returning[result.count] = column;
+    ++result.count;
+    column_start = end + 1;
+    return result.count == returning.size();
+  };
+
+  for (std::size_t block_start = 0; block_start < in.size(); block_start += BLOCK_SIZE) {
+    Column_masks masks = masks_at(in, block_start, kernel);
+    const std::uint64_t valid = valid_bits(in, block_start);
+
+    const std::uint64_t inside = prefix_xor(masks.quote & valid) ^ quote_state;
+    quote_state = (inside >> 63) != 0 ? ~std::uint64_t{ 0 } : 0;
+
+    const std::uint64_t commas = masks.comma & valid & ~inside;
+    const std::uint64_t brackets = (masks.open | masks.close) & valid & ~inside;
+
+    if (depth == 0 && brackets == 0) { //every comma ends a column
+      for (std::uint64_t bits = commas; bits != 0; bits &= bits - 1) {
+        if (emit(block_start + static_cast<std::size_t>(std::countr_zero(bits)))) {
+          result.rest = column_start;
+          return result;
+        }
+      }
+      continue;
+    }
+
+    for (std::uint64_t bits = commas | brackets; bits != 0; bits &= bits - 1) {
+      const std::uint64_t bit = bits & (~bits + 1);
+      const std::size_t at = block_start + static_cast<std::size_t>(std::countr_zero(bits));
+      if ((masks.open & bit) != 0) {
+        if (depth > 0 || at == column_start) {
+          ++depth;
+        }
+      } else if ((masks.close & bit) != 0) {
+        if (depth > 0) {
+          --depth;
+        }
+      } else if (depth == 0) {
+        if (emit(at)) {
+          result.rest = column_start;
+          return result;
+        }
+      }
+    }
+  }
+
+  std::string_view last = in.substr(column_start);
+  if (!last.empty() && opens_column(last.front())) {
+    if (last.size() > 1 && last.back() == closer_of(last.front())) {
+      last = last.substr(1, last.size() - 2);
+    } else {
+      result.unterminated = last.front();
+      return result;
+    }
+  }
+  returning[result.count] = last;
+  ++result.count;
+  return result;
+}